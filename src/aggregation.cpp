@@ -0,0 +1,295 @@
+#include "aggregation.h"
+
+#include "application.h"
+#include "json.h"
+#include "plan.h"
+#include "timesheetsnapshot.h"
+
+#include <QThreadPool>
+#include <algorithm>
+#include <exception>
+#include <latch>
+
+namespace
+{
+
+using Record = TimeSheetSnapshot::IntervalRecord;
+
+constexpr auto actual_key = "actual";
+constexpr auto planned_key = "planned";
+constexpr auto sick_key = "sick";
+constexpr auto vacation_key = "vacation";
+constexpr auto holiday_key = "holiday";
+
+[[nodiscard]] std::vector<Period> partition_by_month(const Period& period)
+{
+  std::vector<Period> partitions;
+  for (auto begin = period.first_day(); begin <= period.last_day(); begin = begin.month_end() + 1) {
+    partitions.emplace_back(begin, std::min(begin.month_end(), period.last_day()));
+  }
+  return partitions;
+}
+
+[[nodiscard]] std::size_t month_index(const Period& period, const QDate& date)
+{
+  static constexpr auto months_per_year = 12;
+  const auto first = period.begin();
+  return static_cast<std::size_t>((date.year() - first.year()) * months_per_year + date.month() - first.month());
+}
+
+/**
+ * @brief returns the planned working time and the leave of the days of the period, which are all of the given kind.
+ *  The planned working time of kinds which are not additive is accounted per day, see aggregate().
+ */
+[[nodiscard]] Aggregation::Totals run_totals(const Schedule& schedule, const Plan::Kind kind, const Period& period)
+{
+  const auto normal_working_time = schedule.working_time(period);
+  const auto [sick, vacation, holiday] = Plan::leave(kind, normal_working_time);
+  Aggregation::Totals totals{.sick = sick, .vacation = vacation, .holiday = holiday};
+  if (Plan::is_additive(kind)) {
+    using std::chrono_literals::operator""min;
+    totals.planned = Plan::planned_working_time(kind, normal_working_time, 0min);
+  }
+  return totals;
+}
+
+/**
+ * @brief returns the actual working time of each day of the partition and the planned working time of the days whose
+ *  kind is not additive.
+ */
+[[nodiscard]] std::vector<Aggregation::Totals> aggregate(const TimeSheetSnapshot::PlanRecord& plan,
+                                                         const Period& partition, const std::vector<Plan::Entry>& runs,
+                                                         const std::vector<const Record*>& records,
+                                                         const QDateTime& now)
+{
+  std::vector<Aggregation::Totals> days(partition.days());
+  const auto partition_begin = partition.begin().startOfDay();
+  const auto partition_end = partition.end().addDays(1).startOfDay();
+  using std::chrono_literals::operator""ms;
+  for (const auto* const record : records) {
+    const auto end = std::min(record->end.isValid() ? record->end : now, partition_end);
+    auto slice_begin = std::max(record->begin, partition_begin);
+    auto day = static_cast<std::size_t>(partition.begin().daysTo(slice_begin.date()));
+    while (slice_begin < end) {
+      const auto midnight = slice_begin.date().addDays(1).startOfDay();
+      days.at(day).actual += slice_begin.msecsTo(std::min(end, midnight)) * 1ms;
+      slice_begin = midnight;
+      day += 1;
+    }
+  }
+
+  const auto last_day = [](const Plan::Entry& run) { return run.period.last_day(); };
+  for (auto run = std::ranges::lower_bound(runs, partition.first_day(), std::less<>{}, last_day);
+       run != runs.end() && run->period.first_day() <= partition.last_day(); ++run)
+  {
+    if (Plan::is_additive(run->kind)) {
+      continue;
+    }
+    const auto overlap = run->period.overlap(partition).value();
+    for (auto day = overlap.first_day(); day <= overlap.last_day(); day = day + 1) {
+      auto& totals = days.at(static_cast<std::size_t>(day - partition.first_day()));
+      totals.planned = Plan::planned_working_time(run->kind, plan.schedule.working_time(day), totals.actual_minutes());
+    }
+  }
+  return days;
+}
+
+}  // namespace
+
+std::chrono::minutes Aggregation::Totals::actual_minutes() const noexcept
+{
+  return std::chrono::duration_cast<std::chrono::minutes>(actual);
+}
+
+Aggregation::Totals& Aggregation::Totals::operator+=(const Totals& other) noexcept
+{
+  actual += other.actual;
+  planned += other.planned;
+  sick += other.sick;
+  vacation += other.vacation;
+  holiday += other.holiday;
+  return *this;
+}
+
+Aggregation::Totals& Aggregation::Totals::operator-=(const Totals& other) noexcept
+{
+  actual -= other.actual;
+  planned -= other.planned;
+  sick -= other.sick;
+  vacation -= other.vacation;
+  holiday -= other.holiday;
+  return *this;
+}
+
+Aggregation::Aggregation(std::shared_ptr<const TimeSheetSnapshot> snapshot, const Period& period, QThreadPool& pool)
+  : m_snapshot(std::move(snapshot)), m_period(period)
+{
+  if (!m_period.begin().isValid() || !m_period.end().isValid() || m_period.days() <= 0) {
+    return;
+  }
+
+  const auto& plan = m_snapshot->plan();
+  m_runs = Plan::kind_runs(plan.entries, plan.holiday_calendar, m_period);
+  m_run_sums.reserve(m_runs.size() + 1);
+  for (const auto& [run_period, kind] : m_runs) {
+    auto sum = m_run_sums.back();
+    m_run_sums.emplace_back(sum += ::run_totals(plan.schedule, kind, run_period));
+  }
+
+  // distribute the intervals to the months they touch, so each worker visits only its intervals.
+  const auto partitions = ::partition_by_month(m_period);
+  m_records.resize(partitions.size());
+  const auto now = Application::current_date_time();
+  for (const auto& chunk : m_snapshot->interval_chunks()) {
+    for (const auto& record : *chunk) {
+      if (record.project_id == Project::invalid_id || !record.begin.isValid()) {
+        continue;
+      }
+      const auto first = std::max(record.begin.date(), m_period.begin());
+      const auto last = std::min((record.end.isValid() ? record.end : now).date(), m_period.end());
+      if (first > last) {
+        continue;
+      }
+      if (!record.end.isValid()) {
+        m_open_records.emplace_back(&record);
+        continue;
+      }
+      for (auto i = ::month_index(m_period, first); i <= ::month_index(m_period, last); ++i) {
+        m_records.at(i).emplace_back(&record);
+      }
+    }
+  }
+
+  // a failing worker must count down as well, its error is rethrown once all workers are done.
+  std::vector<std::vector<Totals>> results(partitions.size());
+  std::vector<std::exception_ptr> errors(partitions.size());
+  std::latch done{static_cast<std::ptrdiff_t>(partitions.size())};
+  for (std::size_t i = 0; i < partitions.size(); ++i) {
+    pool.start([&, i]() {
+      try {
+        results.at(i) = ::aggregate(plan, partitions.at(i), m_runs, m_records.at(i), now);
+      } catch (...) {
+        errors.at(i) = std::current_exception();
+      }
+      done.count_down();
+    });
+  }
+  done.wait();
+
+  if (const auto it = std::ranges::find_if(errors, [](const auto& error) { return error != nullptr; });
+      it != errors.end())
+  {
+    std::rethrow_exception(*it);
+  }
+
+  m_prefix_sums.reserve(m_period.days() + 1);
+  for (const auto& days : results) {
+    for (const auto& day : days) {
+      auto sum = m_prefix_sums.back();
+      m_prefix_sums.emplace_back(sum += day);
+    }
+  }
+  m_depends_on_current_time = !m_open_records.empty();
+  update_open_intervals();
+}
+
+const Period& Aggregation::period() const noexcept
+{
+  return m_period;
+}
+
+const std::shared_ptr<const TimeSheetSnapshot>& Aggregation::snapshot() const noexcept
+{
+  return m_snapshot;
+}
+
+bool Aggregation::depends_on_current_time() const noexcept
+{
+  return m_depends_on_current_time;
+}
+
+void Aggregation::update_open_intervals()
+{
+  m_open_days = std::nullopt;
+  m_open_prefix_sums = {Totals{}};
+  if (m_open_records.empty()) {
+    return;
+  }
+  const auto now = Application::current_date_time();
+  const auto begin = std::ranges::min(m_open_records, {}, [](const auto* record) { return record->begin; })->begin;
+  const auto first = std::max(begin.date(), m_period.begin());
+  const auto last = std::min(now.date(), m_period.end());
+  if (first > last) {
+    return;
+  }
+
+  // the planned time of a day may depend on its actual time, hence the closed intervals of the days are aggregated
+  // again and only the difference is kept.
+  const Period days{first, last};
+  std::vector<const Record*> records;
+  for (auto i = ::month_index(m_period, first); i <= ::month_index(m_period, last); ++i) {
+    records.insert(records.end(), m_records.at(i).begin(), m_records.at(i).end());
+  }
+  std::ranges::sort(records);
+  records.erase(std::ranges::unique(records).begin(), records.end());
+  const auto closed = ::aggregate(m_snapshot->plan(), days, m_runs, records, now);
+  records.insert(records.end(), m_open_records.begin(), m_open_records.end());
+  const auto all = ::aggregate(m_snapshot->plan(), days, m_runs, records, now);
+
+  m_open_prefix_sums.reserve(days.days() + 1);
+  for (std::size_t i = 0; i < all.size(); ++i) {
+    auto sum = m_open_prefix_sums.back();
+    m_open_prefix_sums.emplace_back((sum += all.at(i)) -= closed.at(i));
+  }
+  m_open_days = days;
+}
+
+Aggregation::Totals Aggregation::totals(const Period& period) const
+{
+  const auto overlap = m_period.overlap(period);
+  if (!overlap.has_value() || m_prefix_sums.size() <= 1) {
+    return {};
+  }
+  const auto first = static_cast<std::size_t>(overlap->first_day() - m_period.first_day());
+  const auto end = first + static_cast<std::size_t>(overlap->days());
+  auto totals = Totals{m_prefix_sums.at(end)} -= m_prefix_sums.at(first);
+  (totals += run_totals_before(overlap->last_day() + 1)) -= run_totals_before(overlap->first_day());
+  if (const auto open = m_open_days.has_value() ? m_open_days->overlap(period) : std::nullopt; open.has_value()) {
+    const auto open_first = static_cast<std::size_t>(open->first_day() - m_open_days->first_day());
+    const auto open_end = open_first + static_cast<std::size_t>(open->days());
+    (totals += m_open_prefix_sums.at(open_end)) -= m_open_prefix_sums.at(open_first);
+  }
+  return totals;
+}
+
+Aggregation::Totals Aggregation::run_totals_before(const DayNumber day) const
+{
+  // the first run which ends on or after the day contains it, unless the day is after the period.
+  const auto last_day = [](const Plan::Entry& run) { return run.period.last_day(); };
+  const auto it = std::ranges::lower_bound(m_runs, day, std::less<>{}, last_day);
+  auto totals = m_run_sums.at(static_cast<std::size_t>(std::distance(m_runs.begin(), it)));
+  if (it != m_runs.end() && it->period.first_day() < day) {
+    totals += ::run_totals(m_snapshot->plan().schedule, it->kind, Period{it->period.first_day(), day - 1});
+  }
+  return totals;
+}
+
+void to_json(nlohmann::json& j, const Aggregation::Totals& value)
+{
+  j = {
+      {actual_key, value.actual.count()},
+      {planned_key, value.planned},
+      {sick_key, value.sick},
+      {vacation_key, value.vacation},
+      {holiday_key, value.holiday},
+  };
+}
+
+void from_json(const nlohmann::json& j, Aggregation::Totals& value)
+{
+  value.actual = std::chrono::milliseconds{j.at(actual_key).get<std::chrono::milliseconds::rep>()};
+  value.planned = j.at(planned_key);
+  value.sick = j.at(sick_key);
+  value.vacation = j.at(vacation_key);
+  value.holiday = j.at(holiday_key);
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "period.h"
+#include "timesheetsnapshot.h"
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <vector>
+
+class QThreadPool;
+
+/**
+ * @class Aggregation aggregation.h "aggregation.h"
+ * @brief Accumulates the actual, planned, sick, vacation and holiday time of each day of a period.
+ * The period is partitioned into months which are computed in parallel on a thread pool.
+ * The workers read a TimeSheetSnapshot only, hence the GUI may continue editing the time sheet.
+ * The actual working time of each day is stored as prefix sums.
+ * The planned working time and the leave are accounted per run of days of the same kind, using the closed form of
+ * Schedule::working_time, except for the planned working time of kinds which are not additive (see Plan::is_additive).
+ * Hence, the totals of any period are obtained in logarithmic time.
+ * As in DailyMinutes, intervals are split at midnight, open intervals end now and intervals without project are not
+ * accounted for.
+ * The open intervals are accounted separately for the days they touch, hence the aggregation of the closed intervals
+ * can be kept while a timer is running, see update_open_intervals().
+ */
+class Aggregation
+{
+public:
+  struct Totals
+  {
+    std::chrono::milliseconds actual{0};
+    std::chrono::minutes planned{0};
+    std::chrono::minutes sick{0};
+    std::chrono::minutes vacation{0};
+    std::chrono::minutes holiday{0};
+
+    [[nodiscard]] std::chrono::minutes actual_minutes() const noexcept;
+    Totals& operator+=(const Totals& other) noexcept;
+    Totals& operator-=(const Totals& other) noexcept;
+  };
+
+  explicit Aggregation() = default;
+  explicit Aggregation(std::shared_ptr<const TimeSheetSnapshot> snapshot, const Period& period, QThreadPool& pool);
+
+  [[nodiscard]] const Period& period() const noexcept;
+  [[nodiscard]] const std::shared_ptr<const TimeSheetSnapshot>& snapshot() const noexcept;
+
+  /**
+   * @brief returns whether the result depends on the current time, i.e., whether any open interval was accounted.
+   */
+  [[nodiscard]] bool depends_on_current_time() const noexcept;
+
+  /**
+   * @brief accounts the open intervals until the current time anew.
+   * Only the days touched by open intervals are aggregated again, the closed intervals of the other days are kept.
+   */
+  void update_open_intervals();
+
+  /**
+   * @brief returns the totals of the days of the given period which are within the aggregated period.
+   */
+  [[nodiscard]] Totals totals(const Period& period) const;
+
+private:
+  using Record = TimeSheetSnapshot::IntervalRecord;
+  std::shared_ptr<const TimeSheetSnapshot> m_snapshot;
+  Period m_period;
+  bool m_depends_on_current_time = false;
+
+  // the closed intervals of each month of the period and the open intervals.
+  std::vector<std::vector<const Record*>> m_records;
+  std::vector<const Record*> m_open_records;
+
+  // m_prefix_sums[i] holds the daily totals of the closed intervals of the days before the i-th day of the period.
+  std::vector<Totals> m_prefix_sums{Totals{}};
+
+  // the kind runs of the period, m_run_sums[i] holds the totals accounted per run of the runs before the i-th run.
+  std::vector<Plan::Entry> m_runs;
+  std::vector<Totals> m_run_sums{Totals{}};
+
+  // the days touched by open intervals and the prefix sums of what the open intervals add on these days.
+  std::optional<Period> m_open_days;
+  std::vector<Totals> m_open_prefix_sums{Totals{}};
+
+  /**
+   * @brief returns the totals accounted per run of the days of the period before the given day.
+   */
+  [[nodiscard]] Totals run_totals_before(DayNumber day) const;
+};
+
+void to_json(nlohmann::json& j, const Aggregation::Totals& value);
+void from_json(const nlohmann::json& j, Aggregation::Totals& value);
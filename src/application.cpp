@@ -15,6 +15,8 @@ namespace
 
 constexpr auto timesheet_filename_option_name = "timesheet-filename";
 constexpr auto current_date_time_option_name = "current-date-time";
+constexpr auto undo_limit_option_name = "undo-limit";
+constexpr auto default_undo_limit = 1000;
 
 [[nodiscard]] auto command_line_args()
 {
@@ -24,6 +26,11 @@ constexpr auto current_date_time_option_name = "current-date-time";
       current_date_time_option_name,
       "Fix the current date time to this value (ISO format). Useful for reproducible debugging and testing.",
       "CURRENT_DATE_TIME"});
+  clp->addOption(QCommandLineOption{
+      undo_limit_option_name,
+      QString("Maximal number of undoable commands, older commands are dropped. 0 means unlimited. Default: %1.")
+          .arg(default_undo_limit),
+      "UNDO_LIMIT", QString::number(default_undo_limit)});
   clp->process(*QApplication::instance());
   return clp;
 }
@@ -42,6 +49,15 @@ Application::Application(int& argc, char** argv) : m_qapp(std::make_unique<QAppl
       fmt::println("Simulating today = {}", *m_current_date_time);
     }
   }
+  auto is_valid_undo_limit = false;
+  if (const auto v = args->value(undo_limit_option_name).toInt(&is_valid_undo_limit);
+      is_valid_undo_limit && v >= 0)
+  {
+    m_undo_stack->set_limit(v);
+  } else {
+    fmt::println("Value '{}' is not a valid undo limit.", args->value(undo_limit_option_name));
+    QApplication::exit(1);
+  }
   if (const auto filenames = args->positionalArguments(); !filenames.empty()) {
     m_timesheet_filename = static_cast<std::filesystem::path>(filenames.front().toStdString());
   }
@@ -1,7 +1,84 @@
 #include "colorutil.h"
 #include <QApplication>
 #include <QDate>
+#include <QEvent>
 #include <QPalette>
+#include <QPointer>
+#include <array>
+
+namespace
+{
+
+struct PaletteColors
+{
+  std::array<QColor, 7> backgrounds;
+  QColor highlight;
+
+  [[nodiscard]] const QColor& background(const int day_of_week) const
+  {
+    return backgrounds.at(day_of_week - 1);
+  }
+};
+
+[[nodiscard]] PaletteColors derive_colors(const QPalette& palette)
+{
+  PaletteColors colors;
+  for (std::size_t i = 0; i < colors.backgrounds.size(); ++i) {
+    const auto d = static_cast<int>(i) + 1;
+    const auto color_factor = d == Qt::Sunday || d == Qt::Saturday ? 0.2 : 0.0;
+    colors.backgrounds.at(i) = ::lerp(color_factor, palette.base().color(), Qt::red);
+  }
+  colors.highlight = palette.highlight().color();
+  return colors;
+}
+
+/**
+ * @brief The colors derived from the application palette, which are updated when the palette changes.
+ *  It is a child of the application, hence it is destroyed along with it. It must only be used from the GUI thread.
+ */
+class PaletteCache : public QObject
+{
+public:
+  explicit PaletteCache(QCoreApplication& application)
+    : QObject(&application), m_colors(::derive_colors(QApplication::palette()))
+  {
+    application.installEventFilter(this);
+  }
+
+  [[nodiscard]] const PaletteColors& colors() const noexcept
+  {
+    return m_colors;
+  }
+
+  bool eventFilter(QObject* const watched, QEvent* const event) override
+  {
+    if (watched == parent() && event->type() == QEvent::ApplicationPaletteChange) {
+      m_colors = ::derive_colors(QApplication::palette());
+    }
+    return false;
+  }
+
+private:
+  PaletteColors m_colors;
+};
+
+[[nodiscard]] const PaletteColors& palette_colors()
+{
+  auto* const application = QCoreApplication::instance();
+  if (application == nullptr) {
+    // without application, the palette cannot change.
+    static const auto colors = ::derive_colors(QApplication::palette());
+    return colors;
+  }
+  // the pointer is reset when the application is destroyed, a cache is created for the next application then.
+  static QPointer<PaletteCache> cache;
+  if (cache.isNull()) {
+    cache = new PaletteCache(*application);
+  }
+  return cache->colors();
+}
+
+}  // namespace
 
 QColor lerp(const double t, const QColor& a, const QColor& b)
 {
@@ -17,12 +94,11 @@ QColor contrast_color(const QColor& color)
 
 QColor background(const QDate& date)
 {
-  const auto d = date.dayOfWeek();
-  const auto color_factor = d == Qt::Sunday || d == Qt::Saturday ? 0.2 : 0.0;
-  return ::lerp(color_factor, QApplication::palette().base().color(), Qt::red);
+  // invalid dates have the background of a working day, as they always had.
+  return ::palette_colors().background(date.isValid() ? date.dayOfWeek() : Qt::Monday);
 }
 
 QColor selected(const QColor& color)
 {
-  return ::lerp(0.2, color, QApplication::palette().highlight().color());
+  return ::lerp(0.2, color, ::palette_colors().highlight);
 }
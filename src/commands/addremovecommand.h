@@ -2,6 +2,9 @@
 
 #include "command.h"
 
+#include <set>
+#include <vector>
+
 template<typename Model, typename Item> class AddRemoveCommand : public Command
 {
 protected:
@@ -66,6 +69,77 @@ public:
   }
 };
 
+template<typename Model, typename Item> class AddRemoveManyCommand : public Command
+{
+protected:
+  explicit AddRemoveManyCommand(Model& model, std::vector<std::unique_ptr<Item>> items)
+    : m_model(model), m_items_owned(std::move(items))
+  {
+    for (const auto& item : m_items_owned) {
+      m_item_refs.insert(item.get());
+    }
+  }
+
+  explicit AddRemoveManyCommand(Model& model, std::set<const Item*> items)
+    : m_model(model), m_item_refs(std::move(items))
+  {
+  }
+
+  void add()
+  {
+    m_model.add(std::move(m_items_owned));
+    m_items_owned.clear();
+  }
+
+  void remove()
+  {
+    m_items_owned = m_model.extract(m_item_refs);
+  }
+
+private:
+  Model& m_model;
+  std::vector<std::unique_ptr<Item>> m_items_owned;
+  std::set<const Item*> m_item_refs;
+};
+
+template<typename Model, typename Item> class AddManyCommand final : public AddRemoveManyCommand<Model, Item>
+{
+public:
+  explicit AddManyCommand(Model& model, std::vector<std::unique_ptr<Item>> items)
+    : AddRemoveManyCommand<Model, Item>(model, std::move(items))
+  {
+  }
+
+  void undo() override
+  {
+    this->remove();
+  }
+
+  void redo() override
+  {
+    this->add();
+  }
+};
+
+template<typename Model, typename Item> class RemoveManyCommand final : public AddRemoveManyCommand<Model, Item>
+{
+public:
+  explicit RemoveManyCommand(Model& model, std::set<const Item*> items)
+    : AddRemoveManyCommand<Model, Item>(model, std::move(items))
+  {
+  }
+
+  void undo() override
+  {
+    this->add();
+  }
+
+  void redo() override
+  {
+    this->remove();
+  }
+};
+
 template<template<typename...> typename CommandT, typename... Args> auto make(Args&&... args)
 {
   auto* command = new CommandT(std::forward<Args>(args)...);
@@ -4,4 +4,13 @@
 
 class Command : public QUndoCommand
 {
+protected:
+  /**
+   * @brief returns a new value for QUndoCommand::id which is distinct from the ids of all other command kinds.
+   */
+  [[nodiscard]] static int make_id() noexcept
+  {
+    static int next_id = 0;
+    return next_id++;
+  }
 };
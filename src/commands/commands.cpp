@@ -8,10 +8,12 @@
 
 void delete_intervals(IntervalModel& interval_model, const std::set<const Interval*>& selection)
 {
-  const auto macro = Application::undo_stack().start_macro(QObject::tr("Delete selected intervals"));
-  for (const auto* const interval : selection) {
-    Application::undo_stack().push(make<RemoveCommand>(interval_model, *interval));
+  if (selection.empty()) {
+    return;
   }
+  auto command = make<RemoveManyCommand>(interval_model, selection);
+  command->setText(QObject::tr("Delete selected intervals"));
+  Application::undo_stack().push(std::move(command));
 }
 
 void split_interval(IntervalModel& interval_model, const Interval& interval)
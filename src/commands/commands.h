@@ -20,11 +20,7 @@ make_modify_interval_command(IntervalModel& interval_model, IntervalT& interval,
     return make_modify_interval_command(interval_model, interval_model.remove_const(interval), std::move(other_value),
                                         std::move(swapper));
   } else {
-    const auto signal = [&interval_model, &interval]() {
-      const auto index = interval_model.index(interval);
-      Q_EMIT interval_model.dataChanged(index, index.siblingAtColumn(interval_model.columnCount({}) - 1));
-      Q_EMIT interval_model.data_changed();
-    };
+    const auto signal = [&interval_model, &interval]() { interval_model.invalidate(interval); };
     return make_modify_command(interval, std::move(other_value), std::move(swapper), std::move(signal));
   }
 }
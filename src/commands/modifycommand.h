@@ -2,6 +2,8 @@
 
 #include "commands/command.h"
 
+#include <concepts>
+
 template<typename Object, typename Value, typename Swapper, typename Signal> class ModifyCommand final : public Command
 {
 public:
@@ -22,6 +24,32 @@ public:
     redo();
   }
 
+  /**
+   * @brief consecutive modifications of the same object with the same swapper can be merged.
+   *  That requires the swapper to be comparable, e.g., a pointer to a member function.
+   */
+  [[nodiscard]] int id() const override
+  {
+    if constexpr (std::equality_comparable<Swapper>) {
+      static const auto id = make_id();
+      return id;
+    } else {
+      return -1;
+    }
+  }
+
+  bool mergeWith(const QUndoCommand* const other) override
+  {
+    if constexpr (std::equality_comparable<Swapper>) {
+      // Commands with equal id are of the same type.
+      // This command keeps the value to restore on undo, the other command's value is an intermediate one.
+      const auto& other_command = static_cast<const ModifyCommand&>(*other);
+      return &other_command.m_object == &m_object && other_command.m_swapper == m_swapper;
+    } else {
+      return false;
+    }
+  }
+
 private:
   Object& m_object;
   Value m_other_value;
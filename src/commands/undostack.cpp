@@ -1,6 +1,8 @@
 #include "commands/undostack.h"
 #include "commands/command.h"
 
+#include <QAction>
+
 const QUndoStack& UndoStack::impl() const noexcept
 {
   return m_impl;
@@ -16,6 +18,39 @@ void UndoStack::push(std::unique_ptr<Command> command)
   m_impl.push(command.release());
 }
 
+void UndoStack::set_limit(const int limit)
+{
+  m_impl.setUndoLimit(limit);
+}
+
+void UndoStack::undo()
+{
+  const Transaction transaction;
+  m_impl.undo();
+}
+
+void UndoStack::redo()
+{
+  const Transaction transaction;
+  m_impl.redo();
+}
+
+QAction* UndoStack::create_undo_action(QObject* const parent)
+{
+  auto* const action = m_impl.createUndoAction(parent);
+  QObject::disconnect(action, &QAction::triggered, &m_impl, &QUndoStack::undo);
+  QObject::connect(action, &QAction::triggered, action, [this]() { undo(); });
+  return action;
+}
+
+QAction* UndoStack::create_redo_action(QObject* const parent)
+{
+  auto* const action = m_impl.createRedoAction(parent);
+  QObject::disconnect(action, &QAction::triggered, &m_impl, &QUndoStack::redo);
+  QObject::connect(action, &QAction::triggered, action, [this]() { redo(); });
+  return action;
+}
+
 UndoStack::Macro::Macro(const QString& text, QUndoStack& stack) : m_stack(stack)
 {
   m_stack.beginMacro(text);
@@ -1,8 +1,11 @@
 #pragma once
 
+#include "transaction.h"
+
 #include <QUndoStack>
 
 class Command;
+class QAction;
 
 class UndoStack
 {
@@ -11,6 +14,30 @@ public:
   [[nodiscard]] QUndoStack& impl() noexcept;
   void push(std::unique_ptr<Command> command);
 
+  /**
+   * @brief limits the number of commands on the stack, the oldest commands are dropped.
+   *  Zero means no limit. The limit can only be changed while the stack is empty.
+   */
+  void set_limit(int limit);
+
+  /**
+   * @brief undo or redo the current command within a Transaction.
+   */
+  void undo();
+  void redo();
+
+  /**
+   * @brief create actions like QUndoStack::createUndoAction and QUndoStack::createRedoAction which trigger
+   *  UndoStack::undo and UndoStack::redo, respectively.
+   */
+  [[nodiscard]] QAction* create_undo_action(QObject* parent);
+  [[nodiscard]] QAction* create_redo_action(QObject* parent);
+
+  /**
+   * @class Macro
+   * @brief Groups the commands pushed during its lifetime into a single undoable command.
+   * The model notifications of these commands are coalesced by a Transaction.
+   */
   class Macro
   {
   public:
@@ -18,6 +45,7 @@ public:
     ~Macro();
 
   private:
+    Transaction m_transaction;
     QUndoStack& m_stack;
   };
 
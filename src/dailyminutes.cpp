@@ -0,0 +1,122 @@
+#include "dailyminutes.h"
+
+#include "application.h"
+#include "interval.h"
+
+#include <QDateTime>
+
+namespace
+{
+
+[[nodiscard]] std::chrono::minutes to_minutes(const std::chrono::milliseconds duration) noexcept
+{
+  return std::chrono::duration_cast<std::chrono::minutes>(duration);
+}
+
+[[nodiscard]] std::chrono::milliseconds lookup(const std::vector<std::chrono::milliseconds>& accumulator,
+                                               const Project::Id project_id)
+{
+  if (project_id >= 0 && static_cast<std::size_t>(project_id) < accumulator.size()) {
+    return accumulator.at(project_id);
+  }
+  using std::chrono_literals::operator""ms;
+  return 0ms;
+}
+
+void add(std::vector<std::chrono::milliseconds>& accumulator, const Project::Id project_id,
+         const std::chrono::milliseconds duration)
+{
+  const auto index = static_cast<std::size_t>(project_id);
+  if (index >= accumulator.size()) {
+    using std::chrono_literals::operator""ms;
+    accumulator.resize(index + 1, 0ms);
+  }
+  accumulator.at(index) += duration;
+}
+
+}  // namespace
+
+DailyMinutes::DailyMinutes(const Period& period, std::vector<const Interval*> intervals) : m_period(period)
+{
+  if (!m_period.begin().isValid() || !m_period.end().isValid() || m_period.days() <= 0) {
+    return;
+  }
+
+  const auto day_count = static_cast<std::size_t>(m_period.days());
+  m_days.resize(day_count);
+  m_day_totals.resize(day_count);
+
+  static constexpr auto begin_projection = [](const Interval* interval) -> const QDateTime& {
+    return interval->begin();
+  };
+  if (!std::ranges::is_sorted(intervals, std::less<>{}, begin_projection)) {
+    std::ranges::sort(intervals, std::less<>{}, begin_projection);
+  }
+
+  const auto period_begin = m_period.begin().startOfDay();
+  const auto period_end = m_period.end().addDays(1).startOfDay();
+  const auto now = Application::current_date_time();
+  using std::chrono_literals::operator""ms;
+  for (const auto* const interval : intervals) {
+    const auto* const project = interval->project();
+    if (project == nullptr || project->id() == Project::invalid_id || !interval->begin().isValid()) {
+      continue;
+    }
+    if (interval->begin() >= period_end) {
+      // the intervals are sorted, all remaining intervals begin after the period.
+      break;
+    }
+
+    const auto end = std::min(interval->end().isValid() ? interval->end() : now, period_end);
+    auto slice_begin = std::max(interval->begin(), period_begin);
+    auto day = static_cast<std::size_t>(m_period.begin().daysTo(slice_begin.date()));
+    while (slice_begin < end) {
+      const auto midnight = slice_begin.date().addDays(1).startOfDay();
+      const auto slice_end = std::min(end, midnight);
+      add(day, project->id(), slice_begin.msecsTo(slice_end) * 1ms);
+      slice_begin = midnight;
+      day += 1;
+    }
+  }
+}
+
+void DailyMinutes::add(const std::size_t day, const Project::Id project_id, const std::chrono::milliseconds duration)
+{
+  ::add(m_days.at(day), project_id, duration);
+  ::add(m_project_totals, project_id, duration);
+  m_day_totals.at(day) += duration;
+  m_total += duration;
+}
+
+const Period& DailyMinutes::period() const noexcept
+{
+  return m_period;
+}
+
+std::chrono::minutes DailyMinutes::minutes(const QDate& date, const Project::Id project_id) const
+{
+  if (!m_period.contains(date) || m_days.empty()) {
+    using std::chrono_literals::operator""min;
+    return 0min;
+  }
+  return ::to_minutes(::lookup(m_days.at(m_period.begin().daysTo(date)), project_id));
+}
+
+std::chrono::minutes DailyMinutes::minutes(const QDate& date) const
+{
+  if (!m_period.contains(date) || m_day_totals.empty()) {
+    using std::chrono_literals::operator""min;
+    return 0min;
+  }
+  return ::to_minutes(m_day_totals.at(m_period.begin().daysTo(date)));
+}
+
+std::chrono::minutes DailyMinutes::minutes(const Project::Id project_id) const
+{
+  return ::to_minutes(::lookup(m_project_totals, project_id));
+}
+
+std::chrono::minutes DailyMinutes::minutes() const
+{
+  return ::to_minutes(m_total);
+}
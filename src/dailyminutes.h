@@ -0,0 +1,41 @@
+#pragma once
+
+#include "period.h"
+#include "project.h"
+
+#include <chrono>
+#include <vector>
+
+class Interval;
+
+/**
+ * @class DailyMinutes dailyminutes.h "dailyminutes.h"
+ * @brief Accumulates the time spent per day and project within a Period.
+ * The intervals are split at midnight, i.e., an interval from 22:00 to 02:00 contributes two hours to each day it
+ * touches, and intervals which begin before the period contribute with their overlapping part only.
+ * The intervals are swept once in chronological order.
+ * Open intervals are considered to end now, intervals without project are not accounted for.
+ * Projects are identified by their Project::Id.
+ */
+class DailyMinutes
+{
+public:
+  explicit DailyMinutes(const Period& period, std::vector<const Interval*> intervals);
+  explicit DailyMinutes() = default;
+
+  [[nodiscard]] const Period& period() const noexcept;
+  [[nodiscard]] std::chrono::minutes minutes(const QDate& date, Project::Id project_id) const;
+  [[nodiscard]] std::chrono::minutes minutes(const QDate& date) const;
+  [[nodiscard]] std::chrono::minutes minutes(Project::Id project_id) const;
+  [[nodiscard]] std::chrono::minutes minutes() const;
+
+private:
+  using Accumulator = std::vector<std::chrono::milliseconds>;
+  Period m_period;
+  std::vector<Accumulator> m_days;
+  std::vector<std::chrono::milliseconds> m_day_totals;
+  Accumulator m_project_totals;
+  std::chrono::milliseconds m_total{0};
+
+  void add(std::size_t day, Project::Id project_id, std::chrono::milliseconds duration);
+};
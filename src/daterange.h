@@ -0,0 +1,133 @@
+#pragma once
+
+#include "daynumber.h"
+
+#include <algorithm>
+#include <compare>
+#include <iterator>
+#include <ranges>
+
+/**
+ * @class DateRange daterange.h "daterange.h"
+ * @brief A lazy random-access range of consecutive dates.
+ * The dates are computed from day numbers on access, hence iterating the range does not allocate.
+ * @see Period::dates
+ */
+class DateRange : public std::ranges::view_interface<DateRange>
+{
+public:
+  class Iterator
+  {
+  public:
+    // the dates are computed on access, hence the iterator can't provide references as legacy iterators would.
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type = QDate;
+    using difference_type = qint64;
+
+    constexpr Iterator() noexcept = default;
+    constexpr explicit Iterator(const DayNumber day) noexcept : m_day(day)
+    {
+    }
+
+    [[nodiscard]] constexpr QDate operator*() const noexcept
+    {
+      return m_day.date();
+    }
+
+    [[nodiscard]] constexpr QDate operator[](const difference_type n) const noexcept
+    {
+      return (m_day + n).date();
+    }
+
+    constexpr Iterator& operator+=(const difference_type n) noexcept
+    {
+      m_day = m_day + n;
+      return *this;
+    }
+
+    constexpr Iterator& operator-=(const difference_type n) noexcept
+    {
+      return *this += -n;
+    }
+
+    constexpr Iterator& operator++() noexcept
+    {
+      return *this += 1;
+    }
+
+    constexpr Iterator operator++(int) noexcept
+    {
+      auto copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    constexpr Iterator& operator--() noexcept
+    {
+      return *this -= 1;
+    }
+
+    constexpr Iterator operator--(int) noexcept
+    {
+      auto copy = *this;
+      --*this;
+      return copy;
+    }
+
+    [[nodiscard]] friend constexpr Iterator operator+(Iterator it, const difference_type n) noexcept
+    {
+      return it += n;
+    }
+
+    [[nodiscard]] friend constexpr Iterator operator+(const difference_type n, Iterator it) noexcept
+    {
+      return it += n;
+    }
+
+    [[nodiscard]] friend constexpr Iterator operator-(Iterator it, const difference_type n) noexcept
+    {
+      return it -= n;
+    }
+
+    [[nodiscard]] friend constexpr difference_type operator-(const Iterator& a, const Iterator& b) noexcept
+    {
+      return a.m_day - b.m_day;
+    }
+
+    friend constexpr std::strong_ordering operator<=>(const Iterator&, const Iterator&) noexcept = default;
+    friend constexpr bool operator==(const Iterator&, const Iterator&) noexcept = default;
+
+  private:
+    DayNumber m_day;
+  };
+
+  constexpr DateRange() noexcept = default;
+
+  /**
+   * @brief creates the range of @p count days starting with @p first_day.
+   *  The range is empty if the first day is invalid or the count is not positive.
+   */
+  constexpr explicit DateRange(const DayNumber first_day, const qint64 count) noexcept
+    : m_begin(first_day), m_end(first_day + std::max(qint64{0}, count))
+  {
+  }
+
+  [[nodiscard]] constexpr Iterator begin() const noexcept
+  {
+    return m_begin;
+  }
+
+  [[nodiscard]] constexpr Iterator end() const noexcept
+  {
+    return m_end;
+  }
+
+private:
+  Iterator m_begin;
+  Iterator m_end;
+};
+
+static_assert(std::ranges::random_access_range<DateRange>);
+static_assert(std::ranges::sized_range<DateRange>);
+static_assert(std::ranges::view<DateRange>);
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <QDate>
+#include <array>
+#include <compare>
+#include <limits>
+
+/**
+ * @class DayNumber daynumber.h "daynumber.h"
+ * @brief A day represented by its Julian day number, which is what a QDate holds internally as well.
+ * In contrast to QDate, the calendar arithmetic (day of week, begin and end of week, month and year) is constexpr
+ * integer math, hence day computations in tight loops do not need to go through QDate.
+ * Converting from and to QDate is free. Like an invalid QDate, an invalid DayNumber compares less than any valid one,
+ * and any arithmetic on it yields an invalid DayNumber again.
+ * The civil calendar is the proleptic Gregorian calendar with a year zero, which matches QDate for years after zero.
+ */
+class DayNumber
+{
+public:
+  struct Civil
+  {
+    int year;
+    int month;
+    int day;
+  };
+
+  constexpr DayNumber() noexcept = default;
+  constexpr explicit DayNumber(const qint64 julian_day) noexcept : m_julian_day(julian_day)
+  {
+  }
+  constexpr explicit DayNumber(const QDate& date) noexcept : m_julian_day(date.toJulianDay())
+  {
+  }
+
+  [[nodiscard]] static constexpr bool is_leap_year(const int year) noexcept
+  {
+    return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+  }
+
+  [[nodiscard]] static constexpr int days_in_month(const int year, const int month) noexcept
+  {
+    constexpr std::array<int, 12> days{31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return month == 2 && is_leap_year(year) ? 29 : days.at(month - 1);
+  }
+
+  // The conversions between civil dates and day numbers follow https://howardhinnant.github.io/date_algorithms.html
+  [[nodiscard]] static constexpr DayNumber from_civil(const Civil& civil) noexcept
+  {
+    const qint64 year = civil.year - (civil.month <= 2 ? 1 : 0);
+    const auto era = (year >= 0 ? year : year - 399) / 400;
+    const auto year_of_era = year - era * 400;
+    const qint64 day_of_year = (153 * (civil.month > 2 ? civil.month - 3 : civil.month + 9) + 2) / 5 + civil.day - 1;
+    const auto day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return DayNumber{era * 146097 + day_of_era - 719468 + julian_day_of_unix_epoch};
+  }
+
+  /**
+   * @brief returns year, month and day. The day number must be valid.
+   */
+  [[nodiscard]] constexpr Civil civil() const noexcept
+  {
+    const auto days = m_julian_day - julian_day_of_unix_epoch + 719468;
+    const auto era = (days >= 0 ? days : days - 146096) / 146097;
+    const auto day_of_era = days - era * 146097;
+    const auto year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+    const auto day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    const auto shifted_month = (5 * day_of_year + 2) / 153;
+    const auto day = static_cast<int>(day_of_year - (153 * shifted_month + 2) / 5 + 1);
+    const auto month = static_cast<int>(shifted_month < 10 ? shifted_month + 3 : shifted_month - 9);
+    return {static_cast<int>(year_of_era + era * 400 + (month <= 2 ? 1 : 0)), month, day};
+  }
+
+  [[nodiscard]] constexpr QDate date() const noexcept
+  {
+    return is_valid() ? QDate::fromJulianDay(m_julian_day) : QDate{};
+  }
+
+  [[nodiscard]] constexpr bool is_valid() const noexcept
+  {
+    return m_julian_day != invalid_julian_day;
+  }
+
+  [[nodiscard]] constexpr qint64 julian_day() const noexcept
+  {
+    return m_julian_day;
+  }
+
+  /**
+   * @brief returns the day of the week, from 1 (Monday) to 7 (Sunday), as QDate::dayOfWeek.
+   */
+  [[nodiscard]] constexpr int day_of_week() const noexcept
+  {
+    // Julian day zero is a Monday.
+    return static_cast<int>((m_julian_day % days_per_week + days_per_week) % days_per_week) + 1;
+  }
+
+  [[nodiscard]] constexpr DayNumber week_begin() const noexcept
+  {
+    return *this - (day_of_week() - 1);
+  }
+
+  [[nodiscard]] constexpr DayNumber week_end() const noexcept
+  {
+    return week_begin() + (days_per_week - 1);
+  }
+
+  [[nodiscard]] constexpr DayNumber month_begin() const noexcept
+  {
+    if (!is_valid()) {
+      return {};
+    }
+    return *this - (civil().day - 1);
+  }
+
+  [[nodiscard]] constexpr DayNumber month_end() const noexcept
+  {
+    if (!is_valid()) {
+      return {};
+    }
+    const auto [year, month, day] = civil();
+    return *this + (days_in_month(year, month) - day);
+  }
+
+  [[nodiscard]] constexpr DayNumber year_begin() const noexcept
+  {
+    return is_valid() ? from_civil({civil().year, 1, 1}) : DayNumber{};
+  }
+
+  [[nodiscard]] constexpr DayNumber year_end() const noexcept
+  {
+    return is_valid() ? from_civil({civil().year + 1, 1, 1}) - 1 : DayNumber{};
+  }
+
+  [[nodiscard]] friend constexpr DayNumber operator+(const DayNumber day, const qint64 days) noexcept
+  {
+    return day.is_valid() ? DayNumber{day.m_julian_day + days} : DayNumber{};
+  }
+
+  [[nodiscard]] friend constexpr DayNumber operator-(const DayNumber day, const qint64 days) noexcept
+  {
+    return day + -days;
+  }
+
+  /**
+   * @brief returns the number of days from b to a. As QDate::daysTo, it is 0 if any of the days is invalid.
+   */
+  [[nodiscard]] friend constexpr qint64 operator-(const DayNumber a, const DayNumber b) noexcept
+  {
+    return a.is_valid() && b.is_valid() ? a.m_julian_day - b.m_julian_day : 0;
+  }
+
+  friend constexpr std::strong_ordering operator<=>(DayNumber, DayNumber) noexcept = default;
+  friend constexpr bool operator==(DayNumber, DayNumber) noexcept = default;
+
+private:
+  static constexpr qint64 invalid_julian_day = std::numeric_limits<qint64>::min();
+  static constexpr qint64 julian_day_of_unix_epoch = 2440588;
+  static constexpr int days_per_week = 7;
+  qint64 m_julian_day = invalid_julian_day;
+};
+
+static_assert(std::is_trivially_copyable_v<DayNumber>);
+static_assert(DayNumber::from_civil({1970, 1, 1}).julian_day() == 2440588);
+static_assert(DayNumber::from_civil({2024, 2, 29}).civil().day == 29);
+static_assert(DayNumber::from_civil({2024, 10, 16}).day_of_week() == Qt::Wednesday);
+static_assert(DayNumber::from_civil({2024, 2, 10}).month_end() == DayNumber::from_civil({2024, 2, 29}));
+static_assert(DayNumber::from_civil({2023, 6, 10}).year_end() == DayNumber::from_civil({2023, 12, 31}));
+static_assert(DayNumber::from_civil({2024, 10, 20}).week_begin() == DayNumber::from_civil({2024, 10, 14}));
@@ -0,0 +1,39 @@
+#include "durationtext.h"
+
+#include <unordered_map>
+
+namespace
+{
+
+// the cache is cleared when it grows beyond this size, which rendering a table in steady state never gets close to.
+constexpr std::size_t max_cache_size = 4096;
+
+[[nodiscard]] QString format(const std::chrono::minutes minutes, const bool ongoing)
+{
+  using std::chrono_literals::operator""h;
+  using std::chrono_literals::operator""min;
+  static constexpr auto field_width = 2;
+  static constexpr auto base = 10;
+  static constexpr auto fill_char = QChar('0');
+  return QStringLiteral("%1%2:%3%4")
+      .arg(minutes < 0min ? "-" : "")
+      .arg(std::abs(minutes / 1h), field_width, base, fill_char)
+      .arg(std::abs(minutes / 1min) % (1h / 1min), field_width, base, fill_char)
+      .arg(ongoing ? "*" : "");
+}
+
+}  // namespace
+
+QString duration_text(const std::chrono::minutes minutes, const bool ongoing)
+{
+  thread_local std::unordered_map<std::chrono::minutes::rep, QString> cache;
+  thread_local std::unordered_map<std::chrono::minutes::rep, QString> ongoing_cache;
+  auto& texts = ongoing ? ongoing_cache : cache;
+  if (const auto it = texts.find(minutes.count()); it != texts.end()) {
+    return it->second;
+  }
+  if (texts.size() >= max_cache_size) {
+    texts.clear();
+  }
+  return texts.emplace(minutes.count(), ::format(minutes, ongoing)).first->second;
+}
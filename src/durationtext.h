@@ -0,0 +1,11 @@
+#pragma once
+
+#include <QString>
+#include <chrono>
+
+/**
+ * @brief returns the duration as `[-]HH:MM`, with a trailing `*` if it is still ongoing.
+ *  The texts are cached per thread and minute count. Since QString is implicitly shared, returning a cached text does
+ *  not allocate, which matters for table cells whose data is requested over and over again while rendering.
+ */
+[[nodiscard]] QString duration_text(std::chrono::minutes minutes, bool ongoing = false);
@@ -0,0 +1,108 @@
+#include "holidaycalendar.h"
+
+#include "exceptions.h"
+#include "period.h"
+
+#include <algorithm>
+#include <nlohmann/json.hpp>
+
+namespace
+{
+
+constexpr auto type_key = "type";
+constexpr auto month_key = "month";
+constexpr auto day_key = "day";
+constexpr auto weekday_key = "weekday";
+constexpr auto n_key = "n";
+constexpr auto offset_key = "offset";
+constexpr auto fixed_type = "fixed";
+constexpr auto easter_type = "easter";
+constexpr auto nth_weekday_type = "nth_weekday";
+
+}  // namespace
+
+HolidayCalendar::HolidayCalendar(std::vector<HolidayRule> rules) : m_rules(std::move(rules))
+{
+}
+
+std::vector<DayNumber> HolidayCalendar::holidays(const Period& period) const
+{
+  const auto first_day = period.first_day();
+  const auto last_day = period.last_day();
+  if (m_rules.empty() || !first_day.is_valid() || !last_day.is_valid() || first_day > last_day) {
+    return {};
+  }
+
+  std::vector<DayNumber> holidays;
+  for (auto year = first_day.civil().year; year <= last_day.civil().year; ++year) {
+    for (const auto& rule : m_rules) {
+      if (const auto day = rule.in(year); day.is_valid() && first_day <= day && day <= last_day) {
+        holidays.push_back(day);
+      }
+    }
+  }
+  std::ranges::sort(holidays);
+  const auto duplicates = std::ranges::unique(holidays);
+  holidays.erase(duplicates.begin(), duplicates.end());
+  return holidays;
+}
+
+bool HolidayCalendar::is_holiday(const DayNumber day) const noexcept
+{
+  if (!day.is_valid()) {
+    return false;
+  }
+  const auto year = day.civil().year;
+  return std::ranges::any_of(m_rules, [day, year](const auto& rule) { return rule.in(year) == day; });
+}
+
+const std::vector<HolidayRule>& HolidayCalendar::rules() const noexcept
+{
+  return m_rules;
+}
+
+bool HolidayCalendar::empty() const noexcept
+{
+  return m_rules.empty();
+}
+
+void to_json(nlohmann::json& j, const HolidayRule& value)
+{
+  switch (value.type) {
+    using enum HolidayRule::Type;
+  case Fixed:
+    j = {{type_key, fixed_type}, {month_key, value.month}, {day_key, value.day}};
+    return;
+  case Easter:
+    j = {{type_key, easter_type}, {offset_key, value.offset}};
+    return;
+  case NthWeekday:
+    j = {{type_key, nth_weekday_type}, {month_key, value.month}, {weekday_key, value.weekday}, {n_key, value.n}};
+    return;
+  }
+  Q_UNREACHABLE();
+}
+
+void from_json(const nlohmann::json& j, HolidayRule& value)
+{
+  const std::string type = j.at(type_key);
+  if (type == fixed_type) {
+    value = HolidayRule::fixed(j.at(month_key), j.at(day_key));
+  } else if (type == easter_type) {
+    value = HolidayRule::easter(j.at(offset_key));
+  } else if (type == nth_weekday_type) {
+    value = HolidayRule::nth_weekday(j.at(month_key), j.at(weekday_key), j.at(n_key));
+  } else {
+    throw RuntimeError("Unknown type of holiday rule: {}", type);
+  }
+}
+
+void to_json(nlohmann::json& j, const HolidayCalendar& value)
+{
+  j = value.rules();
+}
+
+void from_json(const nlohmann::json& j, HolidayCalendar& value)
+{
+  value = HolidayCalendar{j.get<std::vector<HolidayRule>>()};
+}
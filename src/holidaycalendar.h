@@ -0,0 +1,151 @@
+#pragma once
+
+#include "daynumber.h"
+
+#include <array>
+#include <nlohmann/json_fwd.hpp>
+#include <vector>
+
+class Period;
+
+/**
+ * @brief returns Easter Sunday of the given year in the Gregorian calendar (anonymous Gregorian computus).
+ */
+[[nodiscard]] constexpr DayNumber easter_sunday(const int year) noexcept
+{
+  const auto a = year % 19;
+  const auto b = year / 100;
+  const auto c = year % 100;
+  const auto d = b / 4;
+  const auto e = b % 4;
+  const auto f = (b + 8) / 25;
+  const auto g = (b - f + 1) / 3;
+  const auto h = (19 * a + b - d - g + 15) % 30;
+  const auto i = c / 4;
+  const auto k = c % 4;
+  const auto l = (32 + 2 * e + 2 * i - h - k) % 7;
+  const auto m = (a + 11 * h + 22 * l) / 451;
+  const auto month = (h + l - 7 * m + 114) / 31;
+  const auto day = (h + l - 7 * m + 114) % 31 + 1;
+  return DayNumber::from_civil({year, month, day});
+}
+
+/**
+ * @class HolidayRule holidaycalendar.h "holidaycalendar.h"
+ * @brief Determines the date of a public holiday in any year.
+ */
+struct HolidayRule
+{
+  enum class Type { Fixed, Easter, NthWeekday };
+  Type type = Type::Fixed;
+  int month = 1;
+  int day = 1;
+
+  // the day of the week from 1 (Monday) to 7 (Sunday), for NthWeekday rules.
+  int weekday = 1;
+
+  // the occurrence of the weekday in the month for NthWeekday rules, negative values count from the end of the month.
+  int n = 1;
+
+  // the days after Easter Sunday, for Easter rules.
+  int offset = 0;
+
+  [[nodiscard]] static constexpr HolidayRule fixed(const int month, const int day) noexcept
+  {
+    return {.type = Type::Fixed, .month = month, .day = day};
+  }
+
+  [[nodiscard]] static constexpr HolidayRule easter(const int offset) noexcept
+  {
+    return {.type = Type::Easter, .offset = offset};
+  }
+
+  [[nodiscard]] static constexpr HolidayRule nth_weekday(const int month, const int weekday, const int n) noexcept
+  {
+    return {.type = Type::NthWeekday, .month = month, .weekday = weekday, .n = n};
+  }
+
+  /**
+   * @brief returns the holiday in the given year, or an invalid day if there is none (e.g., February 29).
+   */
+  [[nodiscard]] constexpr DayNumber in(const int year) const noexcept
+  {
+    constexpr auto days_per_week = 7;
+    if (type == Type::Easter) {
+      return easter_sunday(year) + offset;
+    }
+    if (month < 1 || month > 12) {
+      return {};
+    }
+    if (type == Type::Fixed) {
+      return day >= 1 && day <= DayNumber::days_in_month(year, month) ? DayNumber::from_civil({year, month, day})
+                                                                         : DayNumber{};
+    }
+    if (n == 0 || weekday < 1 || weekday > days_per_week) {
+      return {};
+    }
+    const auto first = DayNumber::from_civil({year, month, 1});
+    const auto last = first.month_end();
+    const auto candidate = n > 0 ? first + (weekday - first.day_of_week() + days_per_week) % days_per_week
+                                       + static_cast<qint64>(days_per_week) * (n - 1)
+                                 : last - (last.day_of_week() - weekday + days_per_week) % days_per_week
+                                       - static_cast<qint64>(days_per_week) * (-n - 1);
+    return first <= candidate && candidate <= last ? candidate : DayNumber{};
+  }
+};
+
+/**
+ * @brief the nationwide public holidays in Germany.
+ */
+constexpr std::array german_public_holidays{
+    HolidayRule::fixed(1, 1),    // New Year's Day
+    HolidayRule::easter(-2),     // Good Friday
+    HolidayRule::easter(1),      // Easter Monday
+    HolidayRule::fixed(5, 1),    // Labour Day
+    HolidayRule::easter(39),     // Ascension Day
+    HolidayRule::easter(50),     // Whit Monday
+    HolidayRule::fixed(10, 3),   // German Unity Day
+    HolidayRule::fixed(12, 25),  // Christmas Day
+    HolidayRule::fixed(12, 26),  // Second Day of Christmas
+};
+
+static_assert(easter_sunday(2000) == DayNumber::from_civil({2000, 4, 23}));
+static_assert(easter_sunday(2024) == DayNumber::from_civil({2024, 3, 31}));
+static_assert(easter_sunday(2025) == DayNumber::from_civil({2025, 4, 20}));
+static_assert(easter_sunday(2038) == DayNumber::from_civil({2038, 4, 25}));
+static_assert(easter_sunday(2285) == DayNumber::from_civil({2285, 3, 22}));
+static_assert(german_public_holidays.at(1).in(2025) == DayNumber::from_civil({2025, 4, 18}));
+static_assert(german_public_holidays.at(4).in(2025) == DayNumber::from_civil({2025, 5, 29}));
+static_assert(german_public_holidays.at(5).in(2024) == DayNumber::from_civil({2024, 5, 20}));
+static_assert(HolidayRule::nth_weekday(11, Qt::Thursday, 4).in(2024) == DayNumber::from_civil({2024, 11, 28}));
+static_assert(HolidayRule::nth_weekday(5, Qt::Monday, -1).in(2025) == DayNumber::from_civil({2025, 5, 26}));
+static_assert(HolidayRule::nth_weekday(2, Qt::Monday, 5).in(2025) == DayNumber{});
+static_assert(HolidayRule::fixed(2, 29).in(2025) == DayNumber{});
+
+/**
+ * @class HolidayCalendar holidaycalendar.h "holidaycalendar.h"
+ * @brief A set of rules for public holidays.
+ * The rules are evaluated for the years in question when asked, the holidays are never stored.
+ */
+class HolidayCalendar
+{
+public:
+  explicit HolidayCalendar() = default;
+  explicit HolidayCalendar(std::vector<HolidayRule> rules);
+
+  /**
+   * @brief returns the holidays within the period in ascending order, without duplicates.
+   */
+  [[nodiscard]] std::vector<DayNumber> holidays(const Period& period) const;
+  [[nodiscard]] bool is_holiday(DayNumber day) const noexcept;
+  [[nodiscard]] const std::vector<HolidayRule>& rules() const noexcept;
+  [[nodiscard]] bool empty() const noexcept;
+
+private:
+  std::vector<HolidayRule> m_rules;
+};
+
+void to_json(nlohmann::json& j, const HolidayRule& value);
+void from_json(const nlohmann::json& j, HolidayRule& value);
+void to_json(nlohmann::json& j, const HolidayCalendar& value);
+void from_json(const nlohmann::json& j, HolidayCalendar& value);
@@ -1,5 +1,6 @@
 #include "interval.h"
 #include "application.h"
+#include "durationtext.h"
 #include "exceptions.h"
 #include "json.h"
 #include "period.h"
@@ -48,18 +49,7 @@ QString Interval::duration_text() const
   if (m_begin.isNull()) {
     return {};
   }
-  const auto duration = (m_end.isNull() ? Application::current_date_time() : m_end) - m_begin;
-  using std::chrono_literals::operator""min;
-  const auto duration_min = duration / 1min;
-  const auto minutes = duration_min % 60;
-  const auto hours = duration_min / 60;
-  static constexpr auto field_width = 2;
-  static constexpr auto base = 10;
-  static constexpr auto fill_char = QChar('0');
-  return QStringLiteral("%1:%2%3")
-      .arg(hours, field_width, base, fill_char)
-      .arg(minutes, field_width, base, fill_char)
-      .arg(m_end.isNull() ? "*" : "");
+  return ::duration_text(duration(), m_end.isNull());
 }
 
 std::chrono::minutes Interval::duration() const
@@ -0,0 +1,249 @@
+#include "intervalindex.h"
+
+#include "interval.h"
+#include "period.h"
+
+#include <algorithm>
+
+void IntervalIndex::insert(Interval& interval)
+{
+  Entry entry{.position = m_positions.emplace(interval.begin(), &interval), .end = interval.end()};
+  if (interval.end().isValid()) {
+    entry.end_position = m_ends.emplace(interval.end());
+    entry.span = std::max(static_cast<qint64>(0), interval.begin().date().daysTo(interval.end().date()));
+    if (const auto duration = std::max(static_cast<qint64>(0), interval.begin().msecsTo(interval.end()));
+        duration > long_duration.count())
+    {
+      m_long_intervals.emplace(&interval);
+    } else {
+      entry.span_position = m_spans.emplace(entry.span);
+      entry.duration = m_durations.emplace(duration);
+    }
+  } else {
+    m_open_intervals.emplace(&interval);
+  }
+  auto& inserted_entry = m_entries.emplace(&interval, entry).first->second;
+
+  for (auto* const other : overlapping(interval, interval.begin(), interval.end())) {
+    add_overlaps(*other, 1);
+    inserted_entry.overlaps += 1;
+  }
+  if (inserted_entry.overlaps > 0) {
+    m_overlapping.emplace(interval.begin(), &interval);
+  }
+}
+
+void IntervalIndex::erase(const Interval& interval)
+{
+  const auto it = m_entries.find(&interval);
+  if (it == m_entries.end()) {
+    return;
+  }
+  auto* const mutable_interval = it->second.position->second;
+  const auto begin = it->second.position->first;
+  // the interval may have been modified already, hence its indexed begin and end determine the overlaps.
+  for (auto* const other : overlapping(interval, begin, it->second.end)) {
+    add_overlaps(*other, -1);
+  }
+  if (it->second.overlaps > 0) {
+    add_overlaps(*mutable_interval, -it->second.overlaps);
+  }
+
+  m_positions.erase(it->second.position);
+  if (it->second.end_position.has_value()) {
+    m_ends.erase(*it->second.end_position);
+  }
+  if (!it->second.end.isValid()) {
+    m_open_intervals.erase(mutable_interval);
+  } else if (it->second.duration.has_value()) {
+    m_spans.erase(*it->second.span_position);
+    m_durations.erase(*it->second.duration);
+  } else {
+    m_long_intervals.erase(mutable_interval);
+  }
+  m_entries.erase(it);
+}
+
+void IntervalIndex::update(const Interval& interval)
+{
+  if (const auto it = m_entries.find(&interval); it != m_entries.end()) {
+    auto& mutable_interval = *it->second.position->second;
+    erase(interval);
+    insert(mutable_interval);
+  }
+}
+
+void IntervalIndex::clear() noexcept
+{
+  m_positions.clear();
+  m_spans.clear();
+  m_ends.clear();
+  m_durations.clear();
+  m_long_intervals.clear();
+  m_open_intervals.clear();
+  m_entries.clear();
+  m_overlapping.clear();
+}
+
+std::vector<Interval*> IntervalIndex::overlapping(const Period& period) const
+{
+  if (!period.begin().isValid() || !period.end().isValid()) {
+    return {};
+  }
+
+  // closed intervals beginning before `first` cannot reach into the period because none spans more days, unless
+  // they are long.
+  const auto max_span = m_spans.empty() ? 0 : *m_spans.rbegin();
+  const auto first = m_positions.lower_bound(period.begin().addDays(-max_span).startOfDay());
+  const auto last = m_positions.lower_bound(period.end().addDays(1).startOfDay());
+
+  std::vector<Interval*> intervals;
+  for (auto* const interval : m_open_intervals) {
+    if (is_before(first, *interval)) {
+      intervals.emplace_back(interval);
+    }
+  }
+  for (auto* const interval : m_long_intervals) {
+    if (is_before(first, *interval) && m_entries.at(interval).end.date() >= period.begin()) {
+      intervals.emplace_back(interval);
+    }
+  }
+  std::ranges::sort(intervals, std::less<>{}, [](const auto* interval) { return interval->begin(); });
+
+  for (auto it = first; it != last; ++it) {
+    auto* const interval = it->second;
+    if (!interval->end().isValid() || interval->end().date() >= period.begin()) {
+      intervals.emplace_back(interval);
+    }
+  }
+  return intervals;
+}
+
+std::optional<Period> IntervalIndex::indexed_period(const Interval& interval, const QDate& until) const
+{
+  const auto it = m_entries.find(&interval);
+  if (it == m_entries.end()) {
+    return std::nullopt;
+  }
+  const auto begin = it->second.position->first.date();
+  const auto end = it->second.end.isValid() ? begin.addDays(it->second.span) : std::max(begin, until);
+  return Period{begin, end};
+}
+
+QDateTime IntervalIndex::last_end() const
+{
+  return m_ends.empty() ? QDateTime{} : *m_ends.rbegin();
+}
+
+bool IntervalIndex::overlaps(const Interval& interval) const
+{
+  const auto it = m_entries.find(&interval);
+  return it != m_entries.end() && it->second.overlaps > 0;
+}
+
+std::size_t IntervalIndex::overlapping_count() const noexcept
+{
+  return m_overlapping.size();
+}
+
+Interval* IntervalIndex::next_overlap(const QDateTime& after) const
+{
+  const auto it = m_overlapping.upper_bound(after);
+  return it == m_overlapping.end() ? nullptr : it->second;
+}
+
+Interval* IntervalIndex::next_gap(const QDateTime& after) const
+{
+  if (!after.isValid()) {
+    const auto first = std::ranges::find_if(m_positions, [](const auto& position) { return position.first.isValid(); });
+    return first == m_positions.end() ? nullptr : next_gap(first->first.addMSecs(-1));
+  }
+  // open intervals cover all the time after their begin.
+  if (std::ranges::any_of(m_open_intervals, [this, &after](const auto* const interval) {
+        const auto& begin = m_entries.at(interval).position->first;
+        return begin.isValid() && begin <= after;
+      }))
+  {
+    return nullptr;
+  }
+
+  // closed intervals beginning before `first` end before `after` unless they are long, the latest end of the former
+  // is covered already.
+  const auto first = window(after);
+  const auto end_before = m_ends.upper_bound(after);
+  auto covered_until = end_before == m_ends.begin() ? QDateTime{} : *std::prev(end_before);
+  for (const auto* const interval : m_long_intervals) {
+    if (is_before(first, *interval)) {
+      covered_until = std::max(covered_until, m_entries.at(interval).end);
+    }
+  }
+  for (auto it = first; it != m_positions.end(); ++it) {
+    const auto& [begin, interval] = *it;
+    if (begin > after && covered_until.isValid() && covered_until < begin && covered_until.date() == begin.date()) {
+      return interval;
+    }
+    const auto& end = m_entries.at(interval).end;
+    if (!end.isValid()) {
+      return nullptr;
+    }
+    covered_until = std::max(covered_until, end);
+  }
+  return nullptr;
+}
+
+std::vector<Interval*> IntervalIndex::overlapping(const Interval& interval, const QDateTime& begin,
+                                                  const QDateTime& end) const
+{
+  if (!begin.isValid()) {
+    return {};
+  }
+
+  const auto first = window(begin);
+  const auto last = end.isValid() ? m_positions.lower_bound(end) : m_positions.end();
+
+  std::vector<Interval*> intervals;
+  for (auto it = first; it != last; ++it) {
+    const auto& other_end = m_entries.at(it->second).end;
+    if (it->second != &interval && other_end.isValid() && other_end > begin) {
+      intervals.emplace_back(it->second);
+    }
+  }
+  for (auto* const other : m_open_intervals) {
+    const auto other_begin = m_entries.at(other).position->first;
+    if (other != &interval && other_begin.isValid() && (!end.isValid() || other_begin < end)) {
+      intervals.emplace_back(other);
+    }
+  }
+  for (auto* const other : m_long_intervals) {
+    if (other != &interval && is_before(first, *other) && m_entries.at(other).end > begin) {
+      intervals.emplace_back(other);
+    }
+  }
+  return intervals;
+}
+
+IntervalIndex::Positions::const_iterator IntervalIndex::window(const QDateTime& time) const
+{
+  // closed intervals which are not long and begin before the window end before `time` because none lasts longer.
+  const auto max_duration = m_durations.empty() ? 0 : *m_durations.rbegin();
+  return m_positions.lower_bound(time.addMSecs(-max_duration));
+}
+
+bool IntervalIndex::is_before(const Positions::const_iterator& window, const Interval& interval) const
+{
+  return window == m_positions.end() || m_entries.at(&interval).position->first < window->first;
+}
+
+void IntervalIndex::add_overlaps(Interval& interval, const int count)
+{
+  auto& entry = m_entries.at(&interval);
+  const auto begin = entry.position->first;
+  if (entry.overlaps == 0 && count > 0) {
+    m_overlapping.emplace(begin, &interval);
+  }
+  entry.overlaps += count;
+  if (entry.overlaps == 0) {
+    const auto [first, last] = m_overlapping.equal_range(begin);
+    m_overlapping.erase(std::find_if(first, last, [&interval](const auto& p) { return p.second == &interval; }));
+  }
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "period.h"
+
+#include <QDateTime>
+#include <chrono>
+#include <map>
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+class Interval;
+
+/**
+ * @class IntervalIndex intervalindex.h "intervalindex.h"
+ * @brief Keeps intervals ordered by their begin to answer range queries without scanning all intervals.
+ * The index does not observe the intervals, it must be updated whenever an interval is added, removed or modified.
+ * It also tracks which intervals overlap with each other. An interval can only overlap with intervals which begin
+ * less than the longest duration before it, hence each update only sweeps over the few intervals in that window.
+ * Closed intervals lasting longer than a day are kept aside, like open intervals, and are visited on each query,
+ * so a single long interval does not widen the window for all others.
+ * Open intervals are considered to last forever.
+ */
+class IntervalIndex
+{
+public:
+  void insert(Interval& interval);
+  void erase(const Interval& interval);
+  void update(const Interval& interval);
+  void clear() noexcept;
+
+  /**
+   * @brief returns the intervals whose dates overlap with the given period, ordered by begin.
+   *  An interval covers the days from the date of its begin to the date of its end.
+   *  Open intervals are considered to overlap with any period that does not end before they begin.
+   */
+  [[nodiscard]] std::vector<Interval*> overlapping(const Period& period) const;
+
+  /**
+   * @brief returns the days covered by the interval at the time it was indexed.
+   *  Open intervals are considered to cover the days until @code until.
+   *  Returns std::nullopt if the interval is not indexed.
+   */
+  [[nodiscard]] std::optional<Period> indexed_period(const Interval& interval, const QDate& until) const;
+
+  /**
+   * @brief returns the latest end of all closed intervals or an invalid QDateTime if there are none.
+   */
+  [[nodiscard]] QDateTime last_end() const;
+
+  /**
+   * @brief returns whether the interval overlaps with any other indexed interval.
+   */
+  [[nodiscard]] bool overlaps(const Interval& interval) const;
+
+  /**
+   * @brief returns the number of intervals which overlap with any other interval.
+   */
+  [[nodiscard]] std::size_t overlapping_count() const noexcept;
+
+  /**
+   * @brief returns the first interval beginning after the given time which overlaps with another interval.
+   *  Returns nullptr if there is none.
+   */
+  [[nodiscard]] Interval* next_overlap(const QDateTime& after) const;
+
+  /**
+   * @brief returns the first interval beginning after the given time which follows a gap on the same day, i.e., no
+   *  interval covers the time between the latest end of the preceding intervals and its begin.
+   *  Returns nullptr if there is none.
+   */
+  [[nodiscard]] Interval* next_gap(const QDateTime& after) const;
+
+private:
+  using Positions = std::multimap<QDateTime, Interval*>;
+  using Spans = std::multiset<qint64>;
+  using Ends = std::multiset<QDateTime>;
+  struct Entry
+  {
+    Positions::iterator position;
+
+    // the end at the time the interval was indexed, invalid if the interval was open.
+    QDateTime end;
+    std::optional<Ends::iterator> end_position;
+
+    // the days the closed interval spans beyond the day of its begin.
+    qint64 span = 0;
+
+    // the positions of span and duration, which are only tracked for closed intervals which are not long.
+    std::optional<Spans::iterator> span_position;
+    std::optional<Spans::iterator> duration;
+
+    // the number of other intervals this interval overlaps with.
+    int overlaps = 0;
+  };
+
+  static constexpr std::chrono::milliseconds long_duration = std::chrono::hours{24};
+
+  Positions m_positions;
+  Ends m_ends;
+
+  // the day spans and the durations in milliseconds of the closed intervals which are not long.
+  Spans m_spans;
+  Spans m_durations;
+  std::set<Interval*> m_long_intervals;
+  std::set<Interval*> m_open_intervals;
+  std::unordered_map<const Interval*, Entry> m_entries;
+  Positions m_overlapping;
+
+  /**
+   * @brief returns the indexed intervals other than @p interval which overlap with the given range.
+   *  An invalid end denotes an open range.
+   */
+  [[nodiscard]] std::vector<Interval*> overlapping(const Interval& interval, const QDateTime& begin,
+                                                   const QDateTime& end) const;
+
+  /**
+   * @brief returns the first position of the window of intervals which may reach @p time.
+   *  Long and open intervals beginning before the window are not in it, see m_long_intervals and m_open_intervals.
+   */
+  [[nodiscard]] Positions::const_iterator window(const QDateTime& time) const;
+  [[nodiscard]] bool is_before(const Positions::const_iterator& window, const Interval& interval) const;
+  void add_overlaps(Interval& interval, int count);
+};
@@ -1,6 +1,7 @@
 #include "intervalmodel.h"
-#include "colorutil.h"
+#include "application.h"
 #include "period.h"
+#include "transaction.h"
 #include <QColor>
 #include <complex>
 #include <nlohmann/json.hpp>
@@ -9,35 +10,19 @@
 namespace
 {
 
-template<typename Intervals> [[nodiscard]] auto find(Intervals&& intervals, const Interval& interval)
+[[nodiscard]] Period covered_period(const Interval& interval)
 {
-  const auto it = std::ranges::find(intervals, &interval, &std::unique_ptr<Interval>::get);
-  struct Info
-  {
-    int row;
-    decltype(it) iterator;
-  };
-  return Info{
-      .row = static_cast<int>(std::distance(intervals.begin(), it)),
-      .iterator = it,
-  };
-}
-
-[[nodiscard]] bool is_match(const Project* project, const std::optional<QString>& name)
-{
-  if (project == nullptr) {
-    return false;
-  }
-  if (name.has_value() && *name != project->name()) {
-    return false;
-  }
-  return true;
+  const auto today = Application::current_date_time().date();
+  const auto begin = interval.begin().isValid() ? interval.begin().date() : today;
+  const auto end = interval.end().isValid() ? interval.end().date() : today;
+  return Period{std::min(begin, end), std::max(begin, end)};
 }
 
 }  // namespace
 
 IntervalModel::IntervalModel(std::deque<std::unique_ptr<Interval>> intervals) : m_intervals(std::move(intervals))
 {
+  rebuild_index();
 }
 
 int IntervalModel::rowCount(const QModelIndex& parent) const
@@ -62,7 +47,10 @@ QVariant IntervalModel::data(const QModelIndex& index, const int role) const
     return project ? project->color() : QVariant{};
   }
   if (role == Qt::ForegroundRole) {
-    return project ? ::contrast_color(project->color()) : QVariant{};
+    return project ? project->contrast_color() : QVariant{};
+  }
+  if (role == Qt::ToolTipRole && m_index.overlaps(*interval)) {
+    return tr("This interval overlaps with another interval, the overlapping time is accounted twice.");
   }
 
   if (role == Qt::DisplayRole) {
@@ -118,69 +106,218 @@ Qt::ItemFlags IntervalModel::flags(const QModelIndex& index) const
 
 QModelIndex IntervalModel::index(const Interval& interval) const
 {
+  const auto it = m_slots.find(&interval);
+  if (it == m_slots.end()) {
+    return {};
+  }
   static constexpr auto column = 0;
-  return index(::find(m_intervals, interval).row, column, {});
+  return index(static_cast<int>(it->second.row), column, {});
 }
 
 Interval& IntervalModel::remove_const(const Interval& interval) const
 {
-  return **::find(m_intervals, interval).iterator;
+  return *m_intervals.at(m_slots.at(&interval).row);
 }
 
 void IntervalModel::add(std::unique_ptr<Interval> interval)
 {
   const auto row = static_cast<int>(m_intervals.size());
   beginInsertRows({}, row, row);
-  m_intervals.emplace_back(std::move(interval));
+  const auto& inserted_interval = *m_intervals.emplace_back(std::move(interval));
+  link(inserted_interval, static_cast<std::size_t>(row), m_last);
+  m_index.insert(inserted_interval);
   endInsertRows();
-  Q_EMIT data_changed();
+  notify_changed(::covered_period(inserted_interval));
 }
 
 void IntervalModel::split_interval(const Interval& interval, const QDateTime& split_point)
 {
-  const auto location = ::find(m_intervals, interval);
-  auto& left_interval = **location.iterator;
-  beginInsertRows({}, location.row, location.row);
-  const auto& right_interval =
-      *m_intervals.emplace(std::next(location.iterator), std::make_unique<Interval>(interval.project()));
-  endInsertRows();
-  right_interval->swap_end(left_interval.end());
+  auto& left_interval = remove_const(interval);
+  // the right half is appended as the last row, it follows the left half in storage order though.
+  const auto row = m_intervals.size();
+  beginInsertRows({}, static_cast<int>(row), static_cast<int>(row));
+  auto& right_interval = *m_intervals.emplace_back(std::make_unique<Interval>(interval.project()));
+  link(right_interval, row, &left_interval);
+  right_interval.swap_end(left_interval.end());
   left_interval.swap_end(split_point);
-  right_interval->swap_begin(split_point);
+  right_interval.swap_begin(split_point);
+  m_index.insert(right_interval);
+  endInsertRows();
+  invalidate(left_interval);
+}
+
+void IntervalModel::invalidate(const Interval& interval)
+{
+  auto affected_period = ::covered_period(interval);
+  if (const auto old_period = m_index.indexed_period(interval, Application::current_date_time().date())) {
+    affected_period = affected_period.united(*old_period);
+  }
+  m_index.update(interval);
+  const auto index = this->index(interval);
+  Q_EMIT dataChanged(index, index.siblingAtColumn(columnCount({}) - 1));
+  notify_changed(affected_period);
+}
+
+void IntervalModel::notify_changed(const Period& affected_period)
+{
+  m_changed_period = m_changed_period.has_value() ? m_changed_period->united(affected_period) : affected_period;
+  Transaction::defer(this, [this]() { Q_EMIT data_changed(*std::exchange(m_changed_period, std::nullopt)); });
 }
 
 std::unique_ptr<Interval> IntervalModel::extract(const Interval& interval)
 {
-  const auto location = ::find(m_intervals, interval);
-  beginRemoveRows({}, location.row, location.row);
-  auto extracted_interval = std::move(*location.iterator);
-  m_intervals.erase(location.iterator);
+  // the last row takes the place of the extracted interval, hence no other row needs to be renumbered.
+  const auto last_row = m_intervals.size() - 1;
+  if (const auto row = m_slots.at(&interval).row; row != last_row) {
+    swap_rows({{row, last_row}});
+  }
+  beginRemoveRows({}, static_cast<int>(last_row), static_cast<int>(last_row));
+  m_index.erase(interval);
+  unlink(interval);
+  auto extracted_interval = std::move(m_intervals.back());
+  m_intervals.pop_back();
   endRemoveRows();
-  Q_EMIT data_changed();
+  notify_changed(::covered_period(*extracted_interval));
   return extracted_interval;
 }
 
+void IntervalModel::add(std::vector<std::unique_ptr<Interval>> intervals)
+{
+  if (intervals.empty()) {
+    return;
+  }
+  const auto first_row = m_intervals.size();
+  auto affected_period = ::covered_period(*intervals.front());
+  beginInsertRows({}, static_cast<int>(first_row), static_cast<int>(first_row + intervals.size() - 1));
+  for (auto& interval : intervals) {
+    const auto& inserted_interval = *m_intervals.emplace_back(std::move(interval));
+    link(inserted_interval, m_intervals.size() - 1, m_last);
+    m_index.insert(inserted_interval);
+    affected_period = affected_period.united(::covered_period(inserted_interval));
+  }
+  endInsertRows();
+  notify_changed(affected_period);
+}
+
+std::vector<std::unique_ptr<Interval>> IntervalModel::extract(const std::set<const Interval*>& intervals)
+{
+  if (intervals.empty()) {
+    return {};
+  }
+
+  // the extracted intervals are swapped into the last rows, which are removed at once then.
+  const auto first_row = m_intervals.size() - intervals.size();
+  std::vector<std::size_t> extracted_rows;
+  for (const auto* const interval : intervals) {
+    if (const auto row = m_slots.at(interval).row; row < first_row) {
+      extracted_rows.emplace_back(row);
+    }
+  }
+  std::vector<std::pair<std::size_t, std::size_t>> swaps;
+  swaps.reserve(extracted_rows.size());
+  auto extracted_row = extracted_rows.begin();
+  for (auto row = first_row; extracted_row != extracted_rows.end(); ++row) {
+    if (!intervals.contains(m_intervals.at(row).get())) {
+      swaps.emplace_back(*extracted_row++, row);
+    }
+  }
+  swap_rows(swaps);
+
+  beginRemoveRows({}, static_cast<int>(first_row), static_cast<int>(m_intervals.size() - 1));
+  const auto first = m_intervals.begin() + static_cast<std::ptrdiff_t>(first_row);
+  auto affected_period = ::covered_period(**first);
+  for (auto interval = first; interval != m_intervals.end(); ++interval) {
+    m_index.erase(**interval);
+    unlink(**interval);
+    affected_period = affected_period.united(::covered_period(**interval));
+  }
+  std::vector<std::unique_ptr<Interval>> extracted_intervals{std::make_move_iterator(first),
+                                                             std::make_move_iterator(m_intervals.end())};
+  m_intervals.erase(first, m_intervals.end());
+  endRemoveRows();
+  notify_changed(affected_period);
+  return extracted_intervals;
+}
+
+void IntervalModel::link(const Interval& interval, const std::size_t row, const Interval* const previous)
+{
+  const auto* const next = previous == nullptr ? m_first : m_slots.at(previous).next;
+  m_slots.insert_or_assign(&interval, Slot{.row = row, .previous = previous, .next = next});
+  (previous == nullptr ? m_first : m_slots.at(previous).next) = &interval;
+  (next == nullptr ? m_last : m_slots.at(next).previous) = &interval;
+}
+
+void IntervalModel::unlink(const Interval& interval)
+{
+  const auto slot = m_slots.at(&interval);
+  (slot.previous == nullptr ? m_first : m_slots.at(slot.previous).next) = slot.next;
+  (slot.next == nullptr ? m_last : m_slots.at(slot.next).previous) = slot.previous;
+  m_slots.erase(&interval);
+}
+
+void IntervalModel::swap_rows(const std::vector<std::pair<std::size_t, std::size_t>>& swaps)
+{
+  if (swaps.empty()) {
+    return;
+  }
+
+  Q_EMIT layoutAboutToBeChanged();
+  QModelIndexList from;
+  QModelIndexList to;
+  std::vector<int> rows;
+  rows.reserve(2 * swaps.size());
+  for (const auto& [a, b] : swaps) {
+    std::swap(m_intervals.at(a), m_intervals.at(b));
+    m_slots.at(m_intervals.at(a).get()).row = a;
+    m_slots.at(m_intervals.at(b).get()).row = b;
+    for (int column = 0; column < columnCount(); ++column) {
+      from << index(static_cast<int>(a), column) << index(static_cast<int>(b), column);
+      to << index(static_cast<int>(b), column) << index(static_cast<int>(a), column);
+    }
+    rows.emplace_back(static_cast<int>(a));
+    rows.emplace_back(static_cast<int>(b));
+  }
+  changePersistentIndexList(from, to);
+  Q_EMIT layoutChanged();
+  Q_EMIT rows_reassigned(rows);
+}
+
 void IntervalModel::set_intervals(std::deque<std::unique_ptr<Interval>> intervals)
 {
   beginResetModel();
   m_intervals = std::move(intervals);
+  rebuild_index();
   endResetModel();
 }
 
+void IntervalModel::rebuild_index()
+{
+  m_index.clear();
+  m_slots.clear();
+  m_slots.reserve(m_intervals.size());
+  m_first = nullptr;
+  m_last = nullptr;
+  for (std::size_t row = 0; row < m_intervals.size(); ++row) {
+    m_index.insert(*m_intervals.at(row));
+    link(*m_intervals.at(row), row, m_last);
+  }
+}
+
 std::vector<Interval*> IntervalModel::intervals() const
 {
-  auto view = m_intervals | std::views::transform(&std::unique_ptr<Interval>::get);
-  return std::vector(view.begin(), view.end());
+  std::vector<Interval*> intervals;
+  intervals.reserve(m_intervals.size());
+  for (const auto* interval = m_first; interval != nullptr;) {
+    const auto& slot = m_slots.at(interval);
+    intervals.emplace_back(m_intervals.at(slot.row).get());
+    interval = slot.next;
+  }
+  return intervals;
 }
 
 std::vector<Interval*> IntervalModel::intervals(const Period& period) const
 {
-  std::vector<Interval> intervals;
-  auto view =
-      m_intervals
-      | std::views::filter([&period](const auto& interval) { return period.contains(interval->begin().date()); })
-      | std::views::transform(&std::unique_ptr<Interval>::get);
-  return std::vector(view.begin(), view.end());
+  return m_index.overlapping(period);
 }
 
 const Interval* IntervalModel::interval(const std::size_t index) const
@@ -196,22 +333,56 @@ std::vector<Interval*> IntervalModel::open_intervals() const
 }
 
 std::chrono::minutes IntervalModel::minutes(const std::optional<Period>& period,
-                                            const std::optional<QString>& name) const
+                                            const std::optional<Project::Id> project_id) const
 {
-  const auto accumulate_minutes_in_period = [period, &name](const std::chrono::minutes accu, const auto& interval) {
-    if (!is_match(interval->project(), name)) {
-      return accu;
-    }
-    if (period.has_value()) {
-      return accu + period->overlap(*interval);
-    }
-    return accu + interval->duration();
-  };
   using std::chrono_literals::operator""min;
-  return std::accumulate(m_intervals.begin(), m_intervals.end(), 0min, accumulate_minutes_in_period);
+  if (!period.has_value()) {
+    const auto accumulate_duration = [project_id](const std::chrono::minutes accu, const auto& interval) {
+      const auto* const project = interval->project();
+      if (project == nullptr || (project_id.has_value() && *project_id != project->id())) {
+        return accu;
+      }
+      return accu + interval->duration();
+    };
+    return std::accumulate(m_intervals.begin(), m_intervals.end(), 0min, accumulate_duration);
+  }
+
+  const auto daily_minutes = this->daily_minutes(*period);
+  return project_id.has_value() ? daily_minutes.minutes(*project_id) : daily_minutes.minutes();
+}
+
+DailyMinutes IntervalModel::daily_minutes(const Period& period) const
+{
+  const auto intervals = this->intervals(period);
+  return DailyMinutes{period, std::vector<const Interval*>(intervals.begin(), intervals.end())};
+}
+
+std::chrono::minutes IntervalModel::minutes(const QDate& date, const std::optional<Project::Id> project_id) const
+{
+  return minutes(Period(date, Period::Type::Day), project_id);
+}
+
+QDateTime IntervalModel::last_end() const
+{
+  return m_index.last_end();
+}
+
+bool IntervalModel::overlaps(const Interval& interval) const
+{
+  return m_index.overlaps(interval);
+}
+
+std::size_t IntervalModel::overlapping_count() const noexcept
+{
+  return m_index.overlapping_count();
+}
+
+const Interval* IntervalModel::next_overlap(const QDateTime& after) const
+{
+  return m_index.next_overlap(after);
 }
 
-std::chrono::minutes IntervalModel::minutes(const QDate& date, const std::optional<QString>& name) const
+const Interval* IntervalModel::next_gap(const QDateTime& after) const
 {
-  return minutes(Period(date, Period::Type::Day), name);
+  return m_index.next_gap(after);
 }
@@ -1,10 +1,14 @@
 #pragma once
 
+#include "dailyminutes.h"
 #include "interval.h"
+#include "intervalindex.h"
 #include "period.h"
 #include "project.h"
 #include <QAbstractTableModel>
 #include <deque>
+#include <set>
+#include <unordered_map>
 
 class IntervalModel final : public QAbstractTableModel
 {
@@ -28,25 +32,106 @@ public:
   Interval& remove_const(const Interval& interval) const;
 
   [[nodiscard]] std::chrono::minutes minutes(const std::optional<Period>& period = std::nullopt,
-                                             const std::optional<QString>& name = std::nullopt) const;
+                                             std::optional<Project::Id> project_id = std::nullopt) const;
   [[nodiscard]] std::chrono::minutes minutes(const QDate& date,
-                                             const std::optional<QString>& name = std::nullopt) const;
+                                             std::optional<Project::Id> project_id = std::nullopt) const;
+  [[nodiscard]] DailyMinutes daily_minutes(const Period& period) const;
 
   void add(std::unique_ptr<Interval> interval);
   std::unique_ptr<Interval> extract(const Interval& interval);
+
+  /**
+   * @brief adds or extracts many intervals at once.
+   *  Adding notifies a single row insertion. Extracting moves the intervals into the last rows with a single layout
+   *  change, and notifies a single removal of these rows.
+   */
+  void add(std::vector<std::unique_ptr<Interval>> intervals);
+  std::vector<std::unique_ptr<Interval>> extract(const std::set<const Interval*>& intervals);
   void split_interval(const Interval& interval, const QDateTime& split_point);
 
+  /**
+   * @brief must be called after the interval has been modified in place.
+   *  Updates the indices and notifies the views.
+   */
+  void invalidate(const Interval& interval);
+
   void set_intervals(std::deque<std::unique_ptr<Interval>> intervals);
+
+  /**
+   * @brief returns all intervals in storage order, i.e., in the order they were added.
+   *  The right half of a split interval follows its left half. The rows are not in storage order, since extracting an
+   *  interval moves the last row into its place.
+   */
   [[nodiscard]] std::vector<Interval*> intervals() const;
+
+  /**
+   * @brief returns the intervals which overlap with the given period, ordered by begin.
+   *  Open intervals are considered to overlap with any period that does not end before they begin.
+   */
   [[nodiscard]] std::vector<Interval*> intervals(const Period& period) const;
   [[nodiscard]] const Interval* interval(std::size_t index) const;
   [[nodiscard]] std::vector<Interval*> open_intervals() const;
 
+  /**
+   * @brief returns the latest end of all closed intervals or an invalid QDateTime if there are none.
+   */
+  [[nodiscard]] QDateTime last_end() const;
+
+  /**
+   * @brief returns whether the interval overlaps with any other interval.
+   *  Overlapping intervals are accounted twice.
+   */
+  [[nodiscard]] bool overlaps(const Interval& interval) const;
+  [[nodiscard]] std::size_t overlapping_count() const noexcept;
+
+  /**
+   * @brief returns the first interval beginning after the given time which overlaps with another interval.
+   *  Returns nullptr if there is none.
+   */
+  [[nodiscard]] const Interval* next_overlap(const QDateTime& after) const;
+
+  /**
+   * @brief returns the first interval beginning after the given time which follows untracked time on the same day.
+   *  Returns nullptr if there is none.
+   */
+  [[nodiscard]] const Interval* next_gap(const QDateTime& after) const;
+
 Q_SIGNALS:
-  void data_changed();
+  /**
+   * @brief emitted after intervals have been added, removed or modified.
+   *  Changes made within a Transaction are reported once when the transaction ends.
+   * @param affected_period the days whose accounted time may have changed.
+   */
+  void data_changed(const Period& affected_period);
+
+  /**
+   * @brief emitted after other intervals have been moved into the given rows, along with layoutChanged.
+   *  The moved intervals are not modified.
+   */
+  void rows_reassigned(const std::vector<int>& rows);
 
 private:
+  /**
+   * @brief the row of an interval and its neighbours in storage order.
+   */
+  struct Slot
+  {
+    std::size_t row;
+    const Interval* previous = nullptr;
+    const Interval* next = nullptr;
+  };
+
   std::deque<std::unique_ptr<Interval>> m_intervals;
+  std::unordered_map<const Interval*, Slot> m_slots;
+  const Interval* m_first = nullptr;
+  const Interval* m_last = nullptr;
+  IntervalIndex m_index;
+  std::optional<Period> m_changed_period;
+  void rebuild_index();
+  void notify_changed(const Period& affected_period);
+  void link(const Interval& interval, std::size_t row, const Interval* previous);
+  void unlink(const Interval& interval);
+  void swap_rows(const std::vector<std::pair<std::size_t, std::size_t>>& swaps);
   [[nodiscard]] QVariant background_data(const QModelIndex& index) const;
 };
 
@@ -0,0 +1,141 @@
+#include "isodate.h"
+#include "daynumber.h"
+
+namespace
+{
+
+constexpr int min_year = 1;
+constexpr int max_year = 9999;
+constexpr int ms_per_second = 1000;
+constexpr int seconds_per_minute = 60;
+constexpr int minutes_per_hour = 60;
+constexpr int hours_per_day = 24;
+
+using CivilDate = DayNumber::Civil;
+
+[[nodiscard]] constexpr std::optional<int> parse_digits(const std::string_view text, const std::size_t pos,
+                                                        const std::size_t count) noexcept
+{
+  int value = 0;
+  for (const auto c : text.substr(pos, count)) {
+    if (c < '0' || c > '9') {
+      return std::nullopt;
+    }
+    value = value * 10 + (c - '0');
+  }
+  return value;
+}
+
+constexpr void format_digits(char* const out, int value, const std::size_t count) noexcept
+{
+  for (auto i = count; i > 0; --i) {
+    out[i - 1] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  }
+}
+
+[[nodiscard]] std::optional<CivilDate> parse_civil_date(const std::string_view text)
+{
+  if (text.size() < iso_date_size || text[4] != '-' || text[7] != '-') {
+    return std::nullopt;
+  }
+  const auto year = ::parse_digits(text, 0, 4);
+  const auto month = ::parse_digits(text, 5, 2);
+  const auto day = ::parse_digits(text, 8, 2);
+  if (!year.has_value() || !month.has_value() || !day.has_value() || *year < min_year || *month < 1
+      || *month > 12 || *day < 1 || *day > DayNumber::days_in_month(*year, *month))
+  {
+    return std::nullopt;
+  }
+  return CivilDate{*year, *month, *day};
+}
+
+[[nodiscard]] QDate to_date(const CivilDate& date)
+{
+  return DayNumber::from_civil(date).date();
+}
+
+[[nodiscard]] std::optional<CivilDate> to_civil_date(const QDate& date)
+{
+  if (!date.isValid()) {
+    return std::nullopt;
+  }
+  const auto civil_date = DayNumber{date}.civil();
+  if (civil_date.year < min_year || civil_date.year > max_year) {
+    return std::nullopt;
+  }
+  return civil_date;
+}
+
+void format_civil_date(const CivilDate& date, char* const out)
+{
+  ::format_digits(out, date.year, 4);
+  out[4] = '-';
+  ::format_digits(out + 5, date.month, 2);
+  out[7] = '-';
+  ::format_digits(out + 8, date.day, 2);
+}
+
+}  // namespace
+
+std::optional<QDate> parse_iso_date(const std::string_view text)
+{
+  if (text.size() != iso_date_size) {
+    return std::nullopt;
+  }
+  const auto date = ::parse_civil_date(text);
+  return date.has_value() ? std::optional{::to_date(*date)} : std::nullopt;
+}
+
+std::optional<QDateTime> parse_iso_date_time(const std::string_view text)
+{
+  if (text.size() != iso_date_time_size || text[10] != 'T' || text[13] != ':' || text[16] != ':') {
+    return std::nullopt;
+  }
+  const auto date = ::parse_civil_date(text);
+  const auto hour = ::parse_digits(text, 11, 2);
+  const auto minute = ::parse_digits(text, 14, 2);
+  const auto second = ::parse_digits(text, 17, 2);
+  if (!date.has_value() || !hour.has_value() || !minute.has_value() || !second.has_value() || *hour >= hours_per_day
+      || *minute >= minutes_per_hour || *second >= seconds_per_minute)
+  {
+    return std::nullopt;
+  }
+  const auto ms = ((*hour * minutes_per_hour + *minute) * seconds_per_minute + *second) * ms_per_second;
+  return QDateTime{::to_date(*date), QTime::fromMSecsSinceStartOfDay(ms)};
+}
+
+std::optional<std::string_view> format_iso_date(const QDate& date, std::array<char, iso_date_size>& buffer)
+{
+  const auto civil_date = ::to_civil_date(date);
+  if (!civil_date.has_value()) {
+    return std::nullopt;
+  }
+  ::format_civil_date(*civil_date, buffer.data());
+  return std::string_view{buffer.data(), buffer.size()};
+}
+
+std::optional<std::string_view> format_iso_date_time(const QDateTime& date_time,
+                                                     std::array<char, iso_date_time_size>& buffer)
+{
+  // Qt appends an offset to any other but local time.
+  if (!date_time.isValid() || date_time.timeSpec() != Qt::LocalTime) {
+    return std::nullopt;
+  }
+  const auto civil_date = ::to_civil_date(date_time.date());
+  if (!civil_date.has_value()) {
+    return std::nullopt;
+  }
+  ::format_civil_date(*civil_date, buffer.data());
+
+  // Qt::ISODate omits the fraction of a second.
+  const auto seconds = date_time.time().msecsSinceStartOfDay() / ms_per_second;
+  const auto minutes = seconds / seconds_per_minute;
+  buffer[10] = 'T';
+  ::format_digits(buffer.data() + 11, minutes / minutes_per_hour, 2);
+  buffer[13] = ':';
+  ::format_digits(buffer.data() + 14, minutes % minutes_per_hour, 2);
+  buffer[16] = ':';
+  ::format_digits(buffer.data() + 17, seconds % seconds_per_minute, 2);
+  return std::string_view{buffer.data(), buffer.size()};
+}
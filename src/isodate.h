@@ -0,0 +1,23 @@
+#pragma once
+
+#include <QDateTime>
+#include <array>
+#include <optional>
+#include <string_view>
+
+constexpr std::size_t iso_date_size = 10;
+constexpr std::size_t iso_date_time_size = 19;
+
+/**
+ * @brief parses and formats the fixed ISO-8601 layouts `YYYY-MM-DD` and `YYYY-MM-DDTHH:MM:SS` of local dates and times,
+ *  which are used throughout the time sheet files.
+ *  The functions work on char spans, do not allocate and yield the same results as Qt::ISODate. Any other layout
+ *  (e.g., with time zone designator or fraction of a second) is rejected with std::nullopt, the caller shall fall back
+ *  to Qt then.
+ */
+[[nodiscard]] std::optional<QDate> parse_iso_date(std::string_view text);
+[[nodiscard]] std::optional<QDateTime> parse_iso_date_time(std::string_view text);
+[[nodiscard]] std::optional<std::string_view> format_iso_date(const QDate& date,
+                                                              std::array<char, iso_date_size>& buffer);
+[[nodiscard]] std::optional<std::string_view> format_iso_date_time(const QDateTime& date_time,
+                                                                   std::array<char, iso_date_time_size>& buffer);
@@ -1,4 +1,5 @@
 #include "json.h"
+#include "isodate.h"
 
 #include <QDateTime>
 #include <nlohmann/json.hpp>
@@ -13,7 +14,8 @@ void adl_serializer<QString>::to_json(json& j, const QString& value)
 
 void adl_serializer<QString>::from_json(const json& j, QString& value)
 {
-  value = QString::fromStdString(static_cast<std::string>(j));
+  const auto& text = j.get_ref<const std::string&>();
+  value = QString::fromUtf8(text.data(), static_cast<qsizetype>(text.size()));
 }
 
 void adl_serializer<std::chrono::minutes>::to_json(json& j, const std::chrono::minutes& value)
@@ -29,22 +31,42 @@ void adl_serializer<std::chrono::minutes>::from_json(const json& j, std::chrono:
 
 void adl_serializer<QDate>::to_json(json& j, const QDate& value)
 {
-  j = value.toString(Qt::ISODate);
+  std::array<char, iso_date_size> buffer{};
+  if (const auto text = ::format_iso_date(value, buffer); text.has_value()) {
+    j = *text;
+  } else {
+    j = value.toString(Qt::ISODate);
+  }
 }
 
 void adl_serializer<QDate>::from_json(const json& j, QDate& value)
 {
-  value = QDate::fromString(j.get<QString>(), Qt::ISODate);
+  const auto& text = j.get_ref<const std::string&>();
+  if (const auto date = ::parse_iso_date(text); date.has_value()) {
+    value = *date;
+  } else {
+    value = QDate::fromString(QString::fromStdString(text), Qt::ISODate);
+  }
 }
 
 void adl_serializer<QDateTime>::to_json(json& j, const QDateTime& value)
 {
-  j = value.toString(Qt::ISODate);
+  std::array<char, iso_date_time_size> buffer{};
+  if (const auto text = ::format_iso_date_time(value, buffer); text.has_value()) {
+    j = *text;
+  } else {
+    j = value.toString(Qt::ISODate);
+  }
 }
 
 void adl_serializer<QDateTime>::from_json(const json& j, QDateTime& value)
 {
-  value = QDateTime::fromString(j.get<QString>(), Qt::ISODate);
+  const auto& text = j.get_ref<const std::string&>();
+  if (const auto date_time = ::parse_iso_date_time(text); date_time.has_value()) {
+    value = *date_time;
+  } else {
+    value = QDateTime::fromString(QString::fromStdString(text), Qt::ISODate);
+  }
 }
 
 void adl_serializer<QList<QString>, void>::to_json(json& j, const QStringList& value)
@@ -0,0 +1,133 @@
+#include "jsonwriter.h"
+#include "isodate.h"
+
+#include <array>
+#include <nlohmann/json.hpp>
+
+JsonWriter::JsonWriter(std::ostream& out) : m_out(out)
+{
+}
+
+void JsonWriter::begin_object()
+{
+  separate();
+  m_out.put('{');
+  m_has_elements.push_back(false);
+}
+
+void JsonWriter::end_object()
+{
+  m_has_elements.pop_back();
+  m_out.put('}');
+}
+
+void JsonWriter::begin_array()
+{
+  separate();
+  m_out.put('[');
+  m_has_elements.push_back(false);
+}
+
+void JsonWriter::end_array()
+{
+  m_has_elements.pop_back();
+  m_out.put(']');
+}
+
+void JsonWriter::key(const std::string_view key)
+{
+  separate();
+  write_string(key);
+  m_out.put(':');
+  m_after_key = true;
+}
+
+void JsonWriter::value(const std::string_view value)
+{
+  separate();
+  write_string(value);
+}
+
+void JsonWriter::value(const std::int64_t value)
+{
+  separate();
+  m_out << value;
+}
+
+void JsonWriter::value(std::nullptr_t)
+{
+  separate();
+  m_out << "null";
+}
+
+void JsonWriter::value(const QDateTime& value)
+{
+  std::array<char, iso_date_time_size> buffer{};
+  if (const auto text = ::format_iso_date_time(value, buffer); text.has_value()) {
+    separate();
+    m_out.put('"').write(text->data(), static_cast<std::streamsize>(text->size())).put('"');
+  } else {
+    this->value(value.toString(Qt::ISODate).toStdString());
+  }
+}
+
+void JsonWriter::document(const nlohmann::json& document)
+{
+  separate();
+  m_out << document.dump();
+}
+
+void JsonWriter::separate()
+{
+  if (m_after_key) {
+    m_after_key = false;
+  } else if (!m_has_elements.empty()) {
+    if (m_has_elements.back()) {
+      m_out.put(',');
+    }
+    m_has_elements.back() = true;
+  }
+}
+
+void JsonWriter::write_string(const std::string_view value)
+{
+  // escapes like nlohmann::json, i.e., control characters without short form are written as lower case \u00xx.
+  static constexpr std::string_view hex_digits = "0123456789abcdef";
+  static constexpr auto first_printable = 0x20;
+  static constexpr auto nibble_size = 4;
+  static constexpr auto nibble_mask = 0xf;
+  m_out.put('"');
+  for (const auto c : value) {
+    switch (c) {
+    case '"':
+      m_out << R"(\")";
+      break;
+    case '\\':
+      m_out << R"(\\)";
+      break;
+    case '\b':
+      m_out << R"(\b)";
+      break;
+    case '\f':
+      m_out << R"(\f)";
+      break;
+    case '\n':
+      m_out << R"(\n)";
+      break;
+    case '\r':
+      m_out << R"(\r)";
+      break;
+    case '\t':
+      m_out << R"(\t)";
+      break;
+    default:
+      if (const auto byte = static_cast<unsigned char>(c); byte < first_printable) {
+        m_out << R"(\u00)" << hex_digits.at(byte >> nibble_size) << hex_digits.at(byte & nibble_mask);
+      } else {
+        m_out.put(c);
+      }
+      break;
+    }
+  }
+  m_out.put('"');
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "json.h"
+
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class JsonWriter jsonwriter.h "jsonwriter.h"
+ * @brief Writes JSON directly to a stream without building a document first.
+ * The output is byte-identical to the compact dump of nlohmann::json, provided that the caller writes the keys of
+ * each object in lexicographical order.
+ */
+class JsonWriter
+{
+public:
+  explicit JsonWriter(std::ostream& out);
+
+  void begin_object();
+  void end_object();
+  void begin_array();
+  void end_array();
+  void key(std::string_view key);
+
+  void value(std::string_view value);
+  void value(std::int64_t value);
+  void value(std::nullptr_t);
+  void value(const QDateTime& value);
+
+  /**
+   * @brief writes a small document as a single value.
+   */
+  void document(const nlohmann::json& document);
+
+private:
+  std::ostream& m_out;
+
+  // whether the current array or object already has an element, i.e., whether the next one needs a separator.
+  std::vector<bool> m_has_elements;
+  bool m_after_key = false;
+  void separate();
+  void write_string(std::string_view value);
+};
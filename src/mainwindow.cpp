@@ -14,10 +14,9 @@
 
 #include <QCloseEvent>
 #include <QFileDialog>
+#include <QLabel>
 #include <QMessageBox>
 #include <fmt/chrono.h>
-#include <fstream>
-#include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
 
 namespace
@@ -36,6 +35,7 @@ MainWindow::MainWindow(QWidget* parent)
   , m_ui(std::make_unique<Ui::MainWindow>())
   , m_time_sheet(std::make_unique<TimeSheet>())
   , m_view_action_group(this)
+  , m_overlap_warning(std::make_unique<QLabel>(this).release())
 {
   m_ui->setupUi(this);
   m_ui->period_detail_view->setContextMenuPolicy(Qt::CustomContextMenu);
@@ -86,11 +86,14 @@ MainWindow::MainWindow(QWidget* parent)
   connect(m_ui->actionNext, &QAction::triggered, this, &MainWindow::next);
   connect(m_ui->actionPrevious, &QAction::triggered, this, &MainWindow::previous);
   connect(m_ui->actionToday, &QAction::triggered, this, &MainWindow::today);
+  connect(m_ui->actionNext_Overlap, &QAction::triggered, this, &MainWindow::next_overlap);
+  connect(m_ui->actionNext_Gap, &QAction::triggered, this, &MainWindow::next_gap);
+  m_ui->statusbar->addPermanentWidget(m_overlap_warning);
 
-  auto* const undo_action = Application::undo_stack().impl().createUndoAction(this);
+  auto* const undo_action = Application::undo_stack().create_undo_action(this);
   m_ui->menu_Edit->addAction(undo_action);
   undo_action->setShortcut(QKeySequence(Qt::CTRL | Qt::Key_Z));
-  auto* const redo_action = Application::undo_stack().impl().createRedoAction(this);
+  auto* const redo_action = Application::undo_stack().create_redo_action(this);
   redo_action->setShortcut(QKeySequence(Qt::CTRL | Qt::Key_Y));
   m_ui->menu_Edit->addAction(redo_action);
 
@@ -111,6 +114,8 @@ void MainWindow::set_time_sheet(std::unique_ptr<TimeSheet> time_sheet)
   m_ui->ganttview->set_time_sheet(m_time_sheet.get());
   m_ui->tv_plan->setModel(&m_time_sheet->plan());
   connect(&m_time_sheet->plan(), &Plan::plan_changed, m_ui->plan_view, &PlanView::invalidate);
+  connect(&m_time_sheet->interval_model(), &IntervalModel::data_changed, this, &MainWindow::update_overlap_warning);
+  update_overlap_warning();
   Application::undo_stack().impl().clear();
 }
 
@@ -210,24 +215,13 @@ bool MainWindow::load(std::filesystem::path filename)
   }
 
   try {
-    std::ifstream ifs(filename);
-    if (!ifs) {
-      QMessageBox::critical(this, QApplication::applicationDisplayName(),
-                            tr("Failed to open '%1' for reading.").arg(QString::fromStdString(m_filename.string())));
-    }
-    nlohmann::json data;
-    ifs >> data;
-    set_time_sheet(::deserialize(data));
+    set_time_sheet(::load(filename));
     set_filename(std::move(filename));
     return true;
   } catch (const DeserializationError& e) {
     QMessageBox::critical(
         this, QApplication::applicationDisplayName(),
         tr("Failed to open '%1': %2").arg(QString::fromStdString(filename.string()), QString::fromStdString(e.what())));
-  } catch (const nlohmann::json::parse_error& e) {
-    QMessageBox::critical(
-        this, QApplication::applicationDisplayName(),
-        tr("Failed to open '%1': %2").arg(QString::fromStdString(filename.string()), QString::fromStdString(e.what())));
   }
   return false;
 }
@@ -238,13 +232,14 @@ bool MainWindow::save()
     return save_as();
   }
 
-  std::ofstream ofs(m_filename);
-  if (!ofs) {
+  try {
+    ::save(*m_time_sheet, m_filename);
+  } catch (const RuntimeError& e) {
     QMessageBox::critical(this, QApplication::applicationDisplayName(),
-                          tr("Failed to open '%1' for writing.").arg(QString::fromStdString(m_filename.string())));
+                          tr("Failed to save '%1': %2")
+                              .arg(QString::fromStdString(m_filename.string()), QString::fromStdString(e.what())));
     return false;
   }
-  ofs << ::serialize(*m_time_sheet);
   Application::undo_stack().impl().setClean();
   return true;
 }
@@ -295,6 +290,41 @@ void MainWindow::today()
   set_date(Application::current_date_time().date());
 }
 
+void MainWindow::next_overlap()
+{
+  const auto& interval_model = m_time_sheet->interval_model();
+  const auto* interval = interval_model.next_overlap(m_current_period.end().endOfDay());
+  if (interval == nullptr) {
+    interval = interval_model.next_overlap(QDateTime{});
+  }
+  if (interval == nullptr) {
+    m_ui->statusbar->showMessage(tr("There are no overlapping intervals."));
+    return;
+  }
+  set_date(interval->begin().date());
+}
+
+void MainWindow::next_gap()
+{
+  const auto& interval_model = m_time_sheet->interval_model();
+  const auto* interval = interval_model.next_gap(m_current_period.end().endOfDay());
+  if (interval == nullptr) {
+    interval = interval_model.next_gap(QDateTime{});
+  }
+  if (interval == nullptr) {
+    m_ui->statusbar->showMessage(tr("There are no gaps between intervals."));
+    return;
+  }
+  set_date(interval->begin().date());
+}
+
+void MainWindow::update_overlap_warning()
+{
+  const auto count = m_time_sheet->interval_model().overlapping_count();
+  m_overlap_warning->setVisible(count > 0);
+  m_overlap_warning->setText(tr("%n interval(s) overlap", nullptr, static_cast<int>(count)));
+}
+
 void MainWindow::set_date(const QDate& date)
 {
   set_period(Period(date, m_current_period.type())
@@ -313,6 +343,12 @@ void MainWindow::set_period(const Period& period)
   }
 
   m_current_period = period.constrained(m_time_sheet->plan().start(), Application::current_date_time().date());
+  try {
+    m_time_sheet->load_segments(m_current_period);
+  } catch (const DeserializationError& e) {
+    QMessageBox::critical(this, QApplication::applicationDisplayName(),
+                          tr("Failed to load the history: %1").arg(QString::fromStdString(e.what())));
+  }
 
   m_ui->period_detail_view->set_period(m_current_period);
   m_ui->plan_view->set_period(m_current_period);
@@ -9,6 +9,7 @@
 #include <memory>
 #include <set>
 
+class QLabel;
 class TimeSheet;
 class UndoStack;
 
@@ -36,6 +37,18 @@ public:
   void next();
   void previous();
   void today();
+
+  /**
+   * @brief shows the period of the next interval after the current period which overlaps with another interval.
+   *  Starts over at the first overlap if there is none after the current period.
+   */
+  void next_overlap();
+
+  /**
+   * @brief shows the period of the next interval after the current period which follows untracked time on its day.
+   *  Starts over at the first gap if there is none after the current period.
+   */
+  void next_gap();
   void set_date(const QDate& date);
   void set_period_type(Period::Type type);
   void set_period(const Period& period);
@@ -51,10 +64,12 @@ private:
   std::unique_ptr<TimeSheet> m_time_sheet;
   std::filesystem::path m_filename;
   QActionGroup m_view_action_group;
+  QLabel* m_overlap_warning;
 
   void end_task();
   void switch_task();
   void update_window_title();
+  void update_overlap_warning();
 
   [[nodiscard]] bool can_close();
   Period m_current_period;
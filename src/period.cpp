@@ -11,7 +11,6 @@
 namespace
 {
 
-constexpr auto number_of_days_in_a_week = 7;
 enum class Rim { Begin, End };
 constexpr auto begin_key = "begin";
 constexpr auto end_key = "end";
@@ -33,30 +32,20 @@ constexpr auto type_key = "type";
   return QString{};
 }
 
-[[nodiscard]] QDate calculate_period(const QDate& date, const Period::Type type, const Rim rim)
+[[nodiscard]] constexpr DayNumber calculate_period(const DayNumber day, const Period::Type type, const Rim rim)
 {
   switch (type) {
     using enum Period::Type;
   case Day:
-    return date;
+    return day;
   case Week:
-    if (const auto begin = date.addDays(Qt::Monday - date.dayOfWeek()); rim == Rim::Begin) {
-      return begin;
-    } else {
-      return begin.addDays(number_of_days_in_a_week - 1);
-    }
+    return rim == Rim::Begin ? day.week_begin() : day.week_end();
   case Month:
-    if (const auto begin = QDate{date.year(), date.month(), 1}; rim == Rim::Begin) {
-      return begin;
-    } else {
-      return begin.addDays(date.daysInMonth() - 1);
-    }
+    return rim == Rim::Begin ? day.month_begin() : day.month_end();
   case Year:
-    if (const auto begin = QDate{date.year(), 1, 1}; rim == Rim::Begin) {
-      return begin;
-    } else {
-      return begin.addDays(date.daysInYear() - 1);
-    }
+    return rim == Rim::Begin ? day.year_begin() : day.year_end();
+  case Custom:
+    break;
   }
   return {};
 }
@@ -64,7 +53,9 @@ constexpr auto type_key = "type";
 }  // namespace
 
 Period::Period(const QDate& date, const Type type)
-  : m_begin(::calculate_period(date, type, Rim::Begin)), m_end(::calculate_period(date, type, Rim::End)), m_type(type)
+  : m_begin(::calculate_period(DayNumber{date}, type, Rim::Begin))
+  , m_end(::calculate_period(DayNumber{date}, type, Rim::End))
+  , m_type(type)
 {
 }
 
@@ -72,12 +63,27 @@ Period::Period(const QDate& begin, const QDate& end) : m_begin(begin), m_end(end
 {
 }
 
-const QDate& Period::begin() const noexcept
+Period::Period(const DayNumber first_day, const DayNumber last_day)
+  : m_begin(first_day), m_end(last_day), m_type(Type::Custom)
+{
+}
+
+QDate Period::begin() const noexcept
+{
+  return m_begin.date();
+}
+
+QDate Period::end() const noexcept
+{
+  return m_end.date();
+}
+
+DayNumber Period::first_day() const noexcept
 {
   return m_begin;
 }
 
-const QDate& Period::end() const noexcept
+DayNumber Period::last_day() const noexcept
 {
   return m_end;
 }
@@ -89,9 +95,17 @@ Period::Type Period::type() const noexcept
 
 std::chrono::minutes Period::overlap(const Interval& interval) const noexcept
 {
-  const auto begin = std::max(m_begin.startOfDay(), interval.begin());
-  const auto end = std::min(m_end.endOfDay(), interval.end());
   using std::chrono_literals::operator""ms;
+  // Resolving the begin and end of a day requires the time zone, which is not necessary if the interval is within.
+  if (interval.begin().isValid() && interval.end().isValid() && m_begin <= DayNumber{interval.begin().date()}
+      && DayNumber{interval.end().date()} <= m_end)
+  {
+    return std::chrono::duration_cast<std::chrono::minutes>(
+        std::max(qint64{0}, interval.begin().msecsTo(interval.end())) * 1ms);
+  }
+
+  const auto begin = std::max(this->begin().startOfDay(), interval.begin());
+  const auto end = std::min(this->end().endOfDay(), interval.end());
   if (begin < end) {
     return std::chrono::duration_cast<std::chrono::minutes>(begin.msecsTo(end) * 1ms);
   }
@@ -102,8 +116,8 @@ std::chrono::minutes Period::overlap(const Interval& interval) const noexcept
 std::optional<Period> Period::overlap(const Period& period) const noexcept
 {
   // TODO better return Period{} if there is no overlap. Ensure that Period{}.days() == 0
-  const auto begin = std::max(this->begin(), period.begin());
-  const auto end = std::min(this->end(), period.end());
+  const auto begin = std::max(m_begin, period.m_begin);
+  const auto end = std::min(m_end, period.m_end);
   if (begin <= end) {
     return Period{begin, end};
   }
@@ -113,27 +127,28 @@ std::optional<Period> Period::overlap(const Period& period) const noexcept
 QString Period::label() const
 {
   const auto verbose_date = QObject::tr("dddd, dd.MM.yyyy");
-  if (!m_begin.isValid() || !m_end.isValid()) {
+  if (!m_begin.is_valid() || !m_end.is_valid()) {
     return QObject::tr("-");
   }
+  const auto begin = this->begin();
   switch (m_type) {
     using enum Type;
   case Year:
-    return QObject::tr("Year %1").arg(m_begin.year());
+    return QObject::tr("Year %1").arg(begin.year());
   case Month:
-    return m_begin.toString("MMMM yyyy");
+    return begin.toString("MMMM yyyy");
   case Week: {
     int year;
-    const auto week_number = m_begin.weekNumber(&year);
+    const auto week_number = begin.weekNumber(&year);
     return QObject::tr("Week %1 in %2 (from %3)")
         .arg(week_number)
         .arg(year)
-        .arg(m_begin.toString(QObject::tr("MMM. dd.")));
+        .arg(begin.toString(QObject::tr("MMM. dd.")));
   }
   case Day:
-    return m_begin.toString(verbose_date);
+    return begin.toString(verbose_date);
   case Custom:
-    return QObject::tr("%1–%2").arg(m_begin.toString(verbose_date), m_end.toString(verbose_date));
+    return QObject::tr("%1–%2").arg(begin.toString(verbose_date), end().toString(verbose_date));
   }
   return {};
 }
@@ -145,12 +160,13 @@ bool Period::contains(const Period& period) const noexcept
 
 bool Period::contains(const QDate& date) const noexcept
 {
-  return m_begin <= date && date <= m_end;
+  const DayNumber day{date};
+  return m_begin <= day && day <= m_end;
 }
 
 std::weak_ordering operator<=>(const Period& a, const Period& b) noexcept
 {
-  return a.limits() <=> b.limits();
+  return std::pair{a.m_begin, a.m_end} <=> std::pair{b.m_begin, b.m_end};
 }
 
 fmt::formatter<Period>::format_return_type fmt::formatter<Period>::format(const Period& p, fmt::format_context& ctx)
@@ -174,7 +190,7 @@ void swap(Period& a, Period& b)
 
 int Period::days() const noexcept
 {
-  return static_cast<int>(m_begin.daysTo(m_end)) + 1;
+  return static_cast<int>(m_end - m_begin) + 1;
 }
 
 QDate Period::clamp(const QDate& date) const noexcept
@@ -183,7 +199,7 @@ QDate Period::clamp(const QDate& date) const noexcept
     return date;
   }
 
-  return std::clamp(date, begin(), end());
+  return std::clamp(DayNumber{date}, m_begin, m_end).date();
 }
 
 QDateTime Period::clamp(const QDateTime& date_time) const noexcept
@@ -195,14 +211,14 @@ QDateTime Period::clamp(const QDateTime& date_time) const noexcept
 Period Period::constrained(const QDate& latest_begin, const QDate& earliest_end) const
 {
   if (m_type == Type::Custom) {
-    return Period{std::min(m_begin, latest_begin), std::max(m_end, earliest_end)};
+    return Period{std::min(m_begin, DayNumber{latest_begin}), std::max(m_end, DayNumber{earliest_end})};
   }
 
-  if (m_end < latest_begin || !m_end.isValid()) {
+  if (m_end < DayNumber{latest_begin} || !m_end.is_valid()) {
     return Period(latest_begin, m_type);
   }
 
-  if (m_begin > earliest_end || !m_begin.isValid()) {
+  if (m_begin > DayNumber{earliest_end} || !m_begin.is_valid()) {
     return Period(earliest_end, m_type);
   }
 
@@ -211,17 +227,17 @@ Period Period::constrained(const QDate& latest_begin, const QDate& earliest_end)
 
 std::pair<QDate, QDate> Period::limits() const noexcept
 {
-  return {m_begin, m_end};
+  return {begin(), end()};
 }
 
-std::vector<QDate> Period::dates() const
+Period Period::united(const Period& other) const
 {
-  std::vector<QDate> days;
-  days.reserve(this->days());
-  for (std::size_t i = 0; i < days.capacity(); ++i) {
-    days.emplace_back(m_begin.addDays(i));
-  }
-  return days;
+  return Period{std::min(m_begin, other.m_begin), std::max(m_end, other.m_end)};
+}
+
+DateRange Period::dates() const noexcept
+{
+  return DateRange{m_begin, days()};
 }
 
 void to_json(nlohmann::json& j, const Period& value)
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "daterange.h"
+#include "daynumber.h"
+
 #include <QDate>
 #include <fmt/format.h>
 #include <nlohmann/json.hpp>
@@ -21,9 +24,16 @@ public:
   enum class Type { Year, Month, Week, Day, Custom };
   explicit Period(const QDate& date, Type type);
   explicit Period(const QDate& begin, const QDate& end);
+  explicit Period(DayNumber first_day, DayNumber last_day);
   explicit Period() = default;
-  [[nodiscard]] const QDate& begin() const noexcept;
-  [[nodiscard]] const QDate& end() const noexcept;
+  [[nodiscard]] QDate begin() const noexcept;
+  [[nodiscard]] QDate end() const noexcept;
+
+  /**
+   * @brief return the first and last day as DayNumber, which allows for arithmetic without QDate.
+   */
+  [[nodiscard]] DayNumber first_day() const noexcept;
+  [[nodiscard]] DayNumber last_day() const noexcept;
   [[nodiscard]] Type type() const noexcept;
   [[nodiscard]] std::chrono::minutes overlap(const Interval& interval) const noexcept;
   [[nodiscard]] std::optional<Period> overlap(const Period& period) const noexcept;
@@ -34,12 +44,21 @@ public:
   [[nodiscard]] QDate clamp(const QDate& date) const noexcept;
   [[nodiscard]] QDateTime clamp(const QDateTime& date_time) const noexcept;
   [[nodiscard]] Period constrained(const QDate& latest_begin, const QDate& earliest_end) const;
+
+  /**
+   * @brief returns the smallest custom period which contains this and the other period.
+   */
+  [[nodiscard]] Period united(const Period& other) const;
   [[nodiscard]] std::pair<QDate, QDate> limits() const noexcept;
-  [[nodiscard]] std::vector<QDate> dates() const;
+
+  /**
+   * @brief returns the dates of the period as lazy range, which does not allocate.
+   */
+  [[nodiscard]] DateRange dates() const noexcept;
 
 private:
-  QDate m_begin;
-  QDate m_end;
+  DayNumber m_begin;
+  DayNumber m_end;
   Type m_type = Type::Custom;
 
   friend std::weak_ordering operator<=>(const Period& a, const Period& b) noexcept;
@@ -5,6 +5,7 @@
 #include "json.h"
 #include "period.h"
 #include "periodedit.h"
+#include "transaction.h"
 
 #include <QDate>
 #include <fmt/ranges.h>
@@ -18,6 +19,8 @@ constexpr auto overtime_offset_key = "overtime_offset";
 constexpr auto periods_key = "periods";
 constexpr auto period_key = "period";
 constexpr auto kind_key = "kind";
+constexpr auto schedule_key = "schedule";
+constexpr auto holidays_key = "holidays";
 
 struct SickLeaveFactors
 {
@@ -71,6 +74,122 @@ struct HolidayLeaveFactors
   }
 };
 
+constexpr auto kind_count = 7;
+
+/**
+ * @brief the leave factors of each kind, i.e., table[kind][i] is the factor of the i-th LeaveFactors.
+ */
+template<typename... LeaveFactors> [[nodiscard]] constexpr auto make_leave_factor_table() noexcept
+{
+  std::array<std::array<double, sizeof...(LeaveFactors)>, kind_count> table{};
+  for (std::size_t kind = 0; kind < table.size(); ++kind) {
+    table.at(kind) = {LeaveFactors::factor(static_cast<Plan::Kind>(kind))...};
+  }
+  return table;
+}
+
+constexpr auto leave_factor_table =
+    make_leave_factor_table<SickLeaveFactors, VacationLeaveFactors, HolidayLeaveFactors>();
+static_assert(leave_factor_table.at(static_cast<std::size_t>(Plan::Kind::HalfVacationHalfHoliday)).at(1) == 0.5);
+
+/**
+ * @brief returns the label of the kind, which is created once and shared afterwards.
+ */
+[[nodiscard]] const QString& kind_label(const Plan::Kind kind)
+{
+  static const auto labels = []() {
+    std::array<QString, kind_count> labels;
+    for (std::size_t kind = 0; kind < labels.size(); ++kind) {
+      labels.at(kind) = QString::fromStdString(fmt::format("{}", static_cast<Plan::Kind>(kind)));
+    }
+    return labels;
+  }();
+  return labels.at(static_cast<std::size_t>(kind));
+}
+
+[[nodiscard]] DayNumber first_day(const std::unique_ptr<Plan::Entry>& entry) noexcept
+{
+  return entry->period.first_day();
+}
+
+[[nodiscard]] const Plan::Entry& entry(const Plan::Entry& entry) noexcept
+{
+  return entry;
+}
+
+[[nodiscard]] const Plan::Entry& entry(const std::unique_ptr<Plan::Entry>& entry) noexcept
+{
+  return *entry;
+}
+
+/**
+ * @brief returns the first entry which ends on or after the given day.
+ *  The periods are sorted and do not overlap, hence their last days are sorted as well.
+ */
+template<typename Entries> [[nodiscard]] auto first_overlapping(const Entries& entries, const DayNumber day)
+{
+  const auto last_day = [](const auto& e) { return ::entry(e).period.last_day(); };
+  return std::ranges::lower_bound(entries, day, std::less<>{}, last_day);
+}
+
+/**
+ * @brief returns the runs of the kinds of the days in the period, see Plan::kind_runs.
+ *  The entries must be sorted and must not overlap.
+ */
+template<typename Entries>
+[[nodiscard]] std::vector<Plan::Entry> kind_runs(const Entries& entries, const HolidayCalendar& holiday_calendar,
+                                                 const Period& period)
+{
+  if (!period.begin().isValid() || !period.end().isValid() || period.days() <= 0) {
+    return {};
+  }
+
+  using Kind = Plan::Kind;
+  std::vector<Plan::Entry> runs;
+  const auto append = [&runs](const DayNumber first_day, const DayNumber last_day, const Kind kind) {
+    if (first_day > last_day) {
+      return;
+    }
+    if (!runs.empty() && runs.back().kind == kind && runs.back().period.last_day() + 1 == first_day) {
+      runs.back().period = Period{runs.back().period.first_day(), last_day};
+    } else {
+      runs.push_back({Period{first_day, last_day}, kind});
+    }
+  };
+
+  // the entries take precedence over the public holidays.
+  const auto holidays = holiday_calendar.holidays(period);
+  auto holiday = holidays.begin();
+  auto next_day = period.first_day();
+  const auto fill_until = [&](const DayNumber end) {
+    for (; holiday != holidays.end() && *holiday < end; ++holiday) {
+      if (*holiday >= next_day) {
+        append(next_day, *holiday - 1, Kind::Normal);
+        append(*holiday, *holiday, Kind::Holiday);
+        next_day = *holiday + 1;
+      }
+    }
+    append(next_day, end - 1, Kind::Normal);
+    next_day = std::max(next_day, end);
+  };
+
+  const auto first = ::first_overlapping(entries, period.first_day());
+  for (const auto& e : std::ranges::subrange(first, std::ranges::end(entries))) {
+    const auto& [entry_period, kind] = ::entry(e);
+    if (entry_period.first_day() > period.last_day()) {
+      // we are past the interesting periods
+      break;
+    }
+    const auto overlap = entry_period.overlap(period);
+    assert(overlap.has_value());
+    fill_until(overlap->first_day());
+    append(overlap->first_day(), overlap->last_day(), kind);
+    next_day = overlap->last_day() + 1;
+  }
+  fill_until(period.last_day() + 1);
+  return runs;
+}
+
 }  // namespace
 
 template<> struct nlohmann::adl_serializer<std::unique_ptr<Plan::Entry>>
@@ -99,6 +218,9 @@ Plan::Plan(const nlohmann::json& data) : m_start(data.at(start_key)), m_overtime
   if (data.contains(periods_key)) {
     m_periods = data.at(periods_key);
   }
+  if (data.contains(holidays_key)) {
+    m_holiday_calendar = data.at(holidays_key);
+  }
   sort();
   if (!is_sorted()) {
     throw RuntimeError("Failed to sort periods in plan: overlapping periods cannot be sorted.");
@@ -111,79 +233,143 @@ Plan::Plan()
 
 nlohmann::json Plan::to_json() const noexcept
 {
-  return {
+  nlohmann::json data{
       {start_key, m_start},
       {overtime_offset_key, m_overtime_offset},
       {periods_key, m_periods},
   };
+  if (!m_holiday_calendar.empty()) {
+    data[holidays_key] = m_holiday_calendar;
+  }
+  return data;
 }
 
 std::chrono::minutes Plan::planned_working_time(const QDate& date, const Kind kind,
-                                                const IntervalModel& interval_model) const noexcept
+                                                const std::chrono::minutes actual_working_time) const noexcept
+{
+  return planned_working_time(kind, planned_normal_working_time(date), actual_working_time);
+}
+
+std::chrono::minutes Plan::planned_working_time(const Kind kind, const std::chrono::minutes normal_working_time,
+                                                const std::chrono::minutes actual_working_time) noexcept
 {
   using enum Kind;
   switch (kind) {
   case Normal:
-    return planned_normal_working_time(date);
+    return normal_working_time;
   case Holiday:
   case Vacation:
   case HalfVacationHalfHoliday:
     using std::chrono_literals::operator""min;
     return 0min;
   case Sick:
-    return std::min(interval_model.minutes(date), planned_normal_working_time(date));
+    return std::min(actual_working_time, normal_working_time);
   case HalfHoliday:
   case HalfVacation:
-    return planned_normal_working_time(date) / 2;
+    return normal_working_time / 2;
   }
   Q_UNREACHABLE();
 }
 
-void Plan::sort() noexcept
+bool Plan::depends_on_actual_working_time(const Kind kind) noexcept
 {
-  std::ranges::sort(m_periods, std::less<>{}, [](const auto& entry) { return entry->period.begin(); });
+  using enum Kind;
+  switch (kind) {
+  case Sick:
+    return true;
+  case Normal:
+  case Holiday:
+  case Vacation:
+  case HalfVacationHalfHoliday:
+  case HalfHoliday:
+  case HalfVacation:
+    return false;
+  }
+  Q_UNREACHABLE();
 }
 
-std::vector<Plan::Kind> Plan::kinds_in(const Period& period) const
+bool Plan::is_additive(const Kind kind) noexcept
 {
-  if (!period.begin().isValid() || !period.end().isValid()) {
-    return {};
+  using enum Kind;
+  switch (kind) {
+  case Normal:
+  case Holiday:
+  case Vacation:
+  case HalfVacationHalfHoliday:
+    return true;
+  case Sick:
+    // depends on the actual working time of the day.
+  case HalfHoliday:
+  case HalfVacation:
+    // the half of the normal working time is rounded per day.
+    return false;
+  }
+  Q_UNREACHABLE();
+}
+
+Schedule Plan::schedule() const
+{
+  const auto monday = m_start.addDays(Qt::Monday - m_start.dayOfWeek());
+  Schedule::Contract contract;
+  for (std::size_t i = 0; i < contract.week.size(); ++i) {
+    contract.week.at(i) = planned_normal_working_time(monday.addDays(static_cast<qint64>(i)));
   }
+  return Schedule{std::vector{contract}};
+}
 
-  std::vector<Kind> kinds;
-  kinds.reserve(period.days());
-  Period active_period = period;
+Plan::LeaveBreakdown Plan::leave(const Kind kind, const std::chrono::minutes normal_working_time) noexcept
+{
+  const auto fraction = [normal_working_time](const double factor) {
+    return std::chrono::duration_cast<std::chrono::minutes>(factor * normal_working_time);
+  };
+  const auto& [sick_factor, vacation_factor, holiday_factor] = leave_factor_table.at(static_cast<std::size_t>(kind));
+  return {.sick = fraction(sick_factor), .vacation = fraction(vacation_factor), .holiday = fraction(holiday_factor)};
+}
+
+void Plan::sort() noexcept
+{
+  std::ranges::sort(m_periods, std::less<>{}, ::first_day);
+}
+
+std::vector<Plan::Entry> Plan::kind_runs(const Period& period) const
+{
   assert(is_sorted());
-  for (const auto& p : m_periods) {
-    if (p->period.begin() > period.end()) {
-      // we are past the interesting periods
-      break;
-    }
-    if (p->period.end() < period.begin()) {
-      // we haven't yet reached the interesting periods
-      continue;
-    }
-    const auto n = std::max(static_cast<qint64>(0), active_period.begin().daysTo(p->period.begin()));
-    kinds.insert(kinds.end(), n, Kind::Normal);
-    const auto overlap = p->period.overlap(active_period);
-    assert(overlap.has_value());
-    kinds.insert(kinds.end(), overlap->days(), p->kind);
-    active_period = Period{p->period.end().addDays(1), active_period.end()};
+  return ::kind_runs(m_periods, m_holiday_calendar, period);
+}
+
+std::vector<Plan::Entry> Plan::kind_runs(const std::vector<Entry>& entries, const HolidayCalendar& holiday_calendar,
+                                         const Period& period)
+{
+  return ::kind_runs(entries, holiday_calendar, period);
+}
+
+std::vector<Plan::Kind> Plan::kinds_in(const Period& period) const
+{
+  std::vector<Kind> kinds;
+  kinds.reserve(std::max(0, period.days()));
+  for (const auto& run : kind_runs(period)) {
+    kinds.insert(kinds.end(), run.period.days(), run.kind);
   }
-  kinds.insert(kinds.end(), std::max(0, active_period.days()), Kind::Normal);
   return kinds;
 }
 
 std::chrono::minutes Plan::planned_working_time(const Period& period, const IntervalModel& interval_model) const
 {
-  const std::vector<Kind> kinds = kinds_in(period);
+  const auto runs = kind_runs(period);
+  const auto actual_working_time =
+      std::ranges::none_of(runs, [](const auto& run) { return depends_on_actual_working_time(run.kind); })
+          ? DailyMinutes{}
+          : interval_model.daily_minutes(period);
   using std::chrono_literals::operator""min;
   auto sum = 0min;
-  for (const auto i : std::views::iota(0, period.days())) {
-    // TODO planned_working_time calls planned_normal_working_time which is virtual.
-    // The virtual lookup doesn't need to be done each time, the runtime type is the same in each iteration, only
-    // the function argument changes.
-    sum += planned_working_time(period.begin().addDays(i), kinds.at(i), interval_model);
+  for (const auto& [run_period, kind] : runs) {
+    if (is_additive(kind)) {
+      sum += planned_working_time(kind, planned_normal_working_time(run_period), 0min);
+    } else {
+      for (const auto date : run_period.dates()) {
+        sum += planned_working_time(date, kind, actual_working_time.minutes(date));
+      }
+    }
   }
   return sum;
 }
@@ -198,13 +384,19 @@ const QDate& Plan::start() const noexcept
   return m_start;
 }
 
+const HolidayCalendar& Plan::holiday_calendar() const noexcept
+{
+  return m_holiday_calendar;
+}
+
 Plan::Kind Plan::find_kind(const QDate& date) const
 {
-  const auto it = std::ranges::find_if(m_periods, [&date](const auto& entry) { return entry->period.contains(date); });
-  if (it == m_periods.end()) {
-    return Kind::Normal;
+  if (const auto it = ::first_overlapping(m_periods, DayNumber{date});
+      it != m_periods.end() && (*it)->period.contains(date))
+  {
+    return (*it)->kind;
   }
-  return (*it)->kind;
+  return m_holiday_calendar.is_holiday(DayNumber{date}) ? Kind::Holiday : Kind::Normal;
 }
 
 Period Plan::default_period() const noexcept
@@ -241,7 +433,7 @@ QVariant Plan::data(const QModelIndex& index, const int role) const
   case period_column:
     return period.label();
   case kind_column:
-    return QString::fromStdString(fmt::format("{}", kind));
+    return ::kind_label(kind);
   default:
     Q_UNREACHABLE();
   }
@@ -270,13 +462,12 @@ Qt::ItemFlags Plan::flags(const QModelIndex& index) const
 std::optional<std::vector<std::unique_ptr<Plan::Entry>>::const_iterator>
 find_period_insert_pos(const std::vector<std::unique_ptr<Plan::Entry>>& periods, const Period& period) noexcept
 {
-  static constexpr auto projection = [](const auto& e) { return e->period.begin(); };
-  const auto insert_pos = std::ranges::upper_bound(periods, period.begin(), std::less<>{}, projection);
-  if (insert_pos != periods.end() && period.end() >= (*insert_pos)->period.begin()) {
+  const auto insert_pos = std::ranges::upper_bound(periods, period.first_day(), std::less<>{}, ::first_day);
+  if (insert_pos != periods.end() && period.last_day() >= (*insert_pos)->period.first_day()) {
     // there is a subsequent period and its beginning is before the candidate's end.
     return {};
   }
-  if (insert_pos != periods.begin() && (*(insert_pos - 1))->period.end() >= period.begin()) {
+  if (insert_pos != periods.begin() && (*(insert_pos - 1))->period.last_day() >= period.first_day()) {
     // there is a previous period and its end is after the candidate's begin.
     return {};
   }
@@ -294,57 +485,135 @@ bool Plan::add(std::unique_ptr<Entry> entry)
   }
 
   const auto row = std::distance(m_periods.cbegin(), *insert_pos);
+  const auto affected_period = entry->period;
   beginInsertRows({}, row, row);
   m_periods.insert(*insert_pos, std::move(entry));
   endInsertRows();
-  Q_EMIT plan_changed();
+  notify_changed(affected_period);
   assert(is_sorted());
   return true;
 }
 
 std::unique_ptr<Plan::Entry> Plan::extract(const Entry& entry)
 {
-  if (const auto it =
-          std::ranges::find_if(m_periods, [&entry](const auto& candidate) { return candidate.get() == &entry; });
-      it != m_periods.end())
+  // the periods do not overlap, hence the first day identifies the entry.
+  if (const auto it = std::ranges::lower_bound(m_periods, entry.period.first_day(), std::less<>{}, ::first_day);
+      it != m_periods.end() && it->get() == &entry)
   {
     const auto row = std::distance(m_periods.begin(), it);
     beginRemoveRows({}, row, row);
     auto ret = std::move(*it);
     m_periods.erase(it);
     endRemoveRows();
-    Q_EMIT plan_changed();
+    notify_changed(ret->period);
     return ret;
   }
   return {};
 }
 
+bool Plan::add(std::vector<std::unique_ptr<Entry>> entries)
+{
+  if (entries.empty()) {
+    return true;
+  }
+
+  std::ranges::sort(entries, std::less<>{}, ::first_day);
+  for (auto it = entries.begin(); it != entries.end(); ++it) {
+    const auto& period = (*it)->period;
+    if ((it != entries.begin() && (*std::prev(it))->period.last_day() >= period.first_day())
+        || !find_period_insert_pos(m_periods, period).has_value())
+    {
+      spdlog::warn("Failed to add {} entries because {} overlaps with another period.", entries.size(), period);
+      return false;
+    }
+  }
+
+  // both sequences are sorted and do not overlap, hence they are merged in a single pass.
+  const auto affected_period = entries.front()->period.united(entries.back()->period);
+  std::vector<std::unique_ptr<Entry>> periods;
+  periods.reserve(m_periods.size() + entries.size());
+  beginResetModel();
+  std::merge(std::make_move_iterator(m_periods.begin()), std::make_move_iterator(m_periods.end()),
+             std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()),
+             std::back_inserter(periods), [](const auto& a, const auto& b) { return ::first_day(a) < ::first_day(b); });
+  m_periods = std::move(periods);
+  endResetModel();
+  notify_changed(affected_period);
+  assert(is_sorted());
+  return true;
+}
+
+std::vector<std::unique_ptr<Plan::Entry>> Plan::extract(const std::set<const Entry*>& entries)
+{
+  if (entries.empty()) {
+    return {};
+  }
+
+  std::vector<std::unique_ptr<Entry>> extracted_entries;
+  beginResetModel();
+  for (auto& entry : m_periods) {
+    if (entries.contains(entry.get())) {
+      extracted_entries.emplace_back(std::move(entry));
+    }
+  }
+  std::erase(m_periods, nullptr);
+  endResetModel();
+  if (!extracted_entries.empty()) {
+    notify_changed(extracted_entries.front()->period.united(extracted_entries.back()->period));
+  }
+  return extracted_entries;
+}
+
 const Plan::Entry& Plan::entry(const int row) const noexcept
 {
   return *m_periods.at(row);
 }
 
-void Plan::data_changed(const int row, const int column)
+void Plan::data_changed(const int row, const int column, const Period& affected_period)
 {
   const auto index = this->index(row, column);
   Q_EMIT dataChanged(index, index);
-  Q_EMIT plan_changed();
+  notify_changed(affected_period);
 }
 
-template<typename LeaveFactors> std::chrono::minutes Plan::count(const Period& period) const
+void Plan::notify_changed(const Period& affected_period)
 {
-  using std::chrono_literals::operator""min;
-  auto sum = 0min;
-  for (const auto& entry : m_periods) {
-    const auto factor = LeaveFactors::factor(entry->kind);
-    const auto intersected_period = entry->period.overlap(period);
-    if (!intersected_period.has_value()) {
-      continue;
+  m_changed_period = m_changed_period.has_value() ? m_changed_period->united(affected_period) : affected_period;
+  Transaction::defer(this, [this]() { Q_EMIT plan_changed(*std::exchange(m_changed_period, std::nullopt)); });
+}
+
+Plan::LeaveBreakdown Plan::leave_breakdown(const Period& period) const
+{
+  static constexpr auto no_leave = std::array{0.0, 0.0, 0.0};
+  LeaveBreakdown breakdown;
+  const auto add_leave = [this, &breakdown](const Kind kind, const Period& leave_period) {
+    const auto& factors = leave_factor_table.at(static_cast<std::size_t>(kind));
+    if (factors == no_leave) {
+      return;
     }
+    const auto [sick, vacation, holiday] = leave(kind, planned_normal_working_time(leave_period));
+    breakdown.sick += sick;
+    breakdown.vacation += vacation;
+    breakdown.holiday += holiday;
+  };
 
-    sum += std::chrono::duration_cast<std::chrono::minutes>(factor * planned_normal_working_time(*intersected_period));
+  for (const auto& entry : std::ranges::subrange(::first_overlapping(m_periods, period.first_day()), m_periods.end())) {
+    if (entry->period.first_day() > period.last_day()) {
+      // the entries are sorted, none of the remaining entries overlaps.
+      break;
+    }
+    if (const auto intersected_period = entry->period.overlap(period); intersected_period.has_value()) {
+      add_leave(entry->kind, *intersected_period);
+    }
   }
-  return sum;
+
+  // the entries take precedence over the public holidays.
+  for (const auto day : m_holiday_calendar.holidays(period)) {
+    if (const auto it = ::first_overlapping(m_periods, day); it == m_periods.end() || (*it)->period.first_day() > day) {
+      add_leave(Kind::Holiday, Period{day, day});
+    }
+  }
+  return breakdown;
 }
 
 std::chrono::minutes Plan::planned_normal_working_time(const Period& period) const noexcept
@@ -361,35 +630,59 @@ void Plan::set_data(const int row, Kind kind)
 {
   using std::swap;
   swap(m_periods.at(row)->kind, kind);
-  data_changed(row, kind_column);
+  data_changed(row, kind_column, m_periods.at(row)->period);
 }
 
 void Plan::set_data(const int row, Period period)
 {
-  Period& old_period = m_periods.at(row)->period;
-  swap(old_period, period);
-  sort();
-  if (!is_sorted()) {
-    swap(old_period, period);
-    sort();
+  const auto size = static_cast<int>(m_periods.size());
+  assert(0 <= row && row < size);
+  // the row before which the entry is to be moved, counted before moving.
+  const auto destination = static_cast<int>(
+      std::distance(m_periods.begin(),
+                    std::ranges::upper_bound(m_periods, period.first_day(), std::less<>{}, ::first_day)));
+  const auto next = destination == row ? row + 1 : destination;
+  const auto previous = destination - 1 == row ? row - 1 : destination - 1;
+  if ((next < size && period.last_day() >= m_periods.at(next)->period.first_day())
+      || (previous >= 0 && m_periods.at(previous)->period.last_day() >= period.first_day()))
+  {
     throw RuntimeError("Failed to change period because it would overlap.");
   }
-  data_changed(row, period_column);
+
+  using std::swap;
+  swap(m_periods.at(row)->period, period);
+  const auto& new_period = m_periods.at(row)->period;
+  auto new_row = row;
+  // moving before the entry itself or its successor keeps the order.
+  if (destination != row && destination != row + 1) {
+    beginMoveRows({}, row, row, {}, destination);
+    const auto it = m_periods.begin() + row;
+    if (destination < row) {
+      std::rotate(m_periods.begin() + destination, it, it + 1);
+      new_row = destination;
+    } else {
+      std::rotate(it, it + 1, m_periods.begin() + destination);
+      new_row = destination - 1;
+    }
+    endMoveRows();
+  }
+  assert(is_sorted());
+  data_changed(new_row, period_column, new_period.united(period));
 }
 
 std::chrono::minutes Plan::sick_time(const Period& period) const
 {
-  return count<SickLeaveFactors>(period);
+  return leave_breakdown(period).sick;
 }
 
 std::chrono::minutes Plan::holiday_time(const Period& period) const
 {
-  return count<HolidayLeaveFactors>(period);
+  return leave_breakdown(period).holiday;
 }
 
 std::chrono::minutes Plan::vacation_time(const Period& period) const
 {
-  return count<VacationLeaveFactors>(period);
+  return leave_breakdown(period).vacation;
 }
 
 std::chrono::minutes FullTimePlan::planned_normal_working_time(const QDate& date) const noexcept
@@ -400,6 +693,37 @@ std::chrono::minutes FullTimePlan::planned_normal_working_time(const QDate& date
   return day == Qt::Saturday || day == Qt::Sunday ? 0min : 8h;
 }
 
+SchedulePlan::SchedulePlan(const nlohmann::json& data)
+  : Plan(data), m_schedule(data.contains(schedule_key) ? data.at(schedule_key).get<Schedule>() : Schedule::full_time())
+{
+}
+
+SchedulePlan::SchedulePlan(Schedule schedule) : m_schedule(std::move(schedule))
+{
+}
+
+nlohmann::json SchedulePlan::to_json() const noexcept
+{
+  auto data = Plan::to_json();
+  data[schedule_key] = m_schedule;
+  return data;
+}
+
+Schedule SchedulePlan::schedule() const
+{
+  return m_schedule;
+}
+
+std::chrono::minutes SchedulePlan::planned_normal_working_time(const QDate& date) const noexcept
+{
+  return m_schedule.working_time(DayNumber{date});
+}
+
+std::chrono::minutes SchedulePlan::planned_normal_working_time(const Period& period) const noexcept
+{
+  return m_schedule.working_time(period);
+}
+
 void to_json(nlohmann::json& j, const Plan::Entry& value)
 {
   j = {
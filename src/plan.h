@@ -2,11 +2,15 @@
 
 #include "application.h"
 #include "fmt.h"
+#include "holidaycalendar.h"
 #include "period.h"
+#include "schedule.h"
 
 #include <QAbstractTableModel>
 #include <QDate>
+#include <array>
 #include <chrono>
+#include <set>
 
 class IntervalModel;
 class QDate;
@@ -19,14 +23,20 @@ public:
   static constexpr auto kind_column = 1;
   explicit Plan(const nlohmann::json& data);
   explicit Plan();
-  [[nodiscard]] nlohmann::json to_json() const noexcept;
+  [[nodiscard]] virtual nlohmann::json to_json() const noexcept;
   [[nodiscard]] std::chrono::minutes planned_working_time(const Period& period,
                                                           const IntervalModel& interval_model) const;
   [[nodiscard]] const std::chrono::minutes& overtime_offset() const noexcept;
   [[nodiscard]] const QDate& start() const noexcept;
 
   enum class Kind { Normal, Sick, Holiday, HalfHoliday, Vacation, HalfVacation, HalfVacationHalfHoliday };
+
+  /**
+   * @brief returns the kind of the entry which contains the date.
+   *  Public holidays of the holiday calendar are of kind Holiday unless an entry contains them.
+   */
   [[nodiscard]] Kind find_kind(const QDate& date) const;
+  [[nodiscard]] const HolidayCalendar& holiday_calendar() const noexcept;
 
   /**
    * @brief return a period which doesn't overlap with any period in this plan.
@@ -49,34 +59,114 @@ public:
   bool add(std::unique_ptr<Entry> entry);
   std::unique_ptr<Entry> extract(const Entry& entry);
 
+  /**
+   * @brief adds or extracts many entries at once with a single model reset.
+   *  The entries are added all or none: if any entry overlaps with another one, the plan is left unchanged.
+   *  Returns whether the entries have been added.
+   */
+  bool add(std::vector<std::unique_ptr<Entry>> entries);
+  std::vector<std::unique_ptr<Entry>> extract(const std::set<const Entry*>& entries);
+
   const Entry& entry(int row) const noexcept;
   void set_data(int row, Kind kind);
+
+  /**
+   * @brief changes the period of the entry in the given row, moving the row to keep the entries sorted.
+   *  Throws a RuntimeError and leaves the plan unchanged if the period would overlap with another entry.
+   */
   void set_data(int row, Period period);
 
+  struct LeaveBreakdown
+  {
+    std::chrono::minutes sick{0};
+    std::chrono::minutes vacation{0};
+    std::chrono::minutes holiday{0};
+  };
+
+  /**
+   * @brief returns the sick, vacation and holiday leave within the given period in a single pass over the entries.
+   *  The normal working time of each day is evaluated once for all categories.
+   */
+  [[nodiscard]] LeaveBreakdown leave_breakdown(const Period& period) const;
   [[nodiscard]] std::chrono::minutes sick_time(const Period& period) const;
   [[nodiscard]] std::chrono::minutes holiday_time(const Period& period) const;
   [[nodiscard]] std::chrono::minutes vacation_time(const Period& period) const;
   [[nodiscard]] std::vector<Kind> kinds_in(const Period& period) const;
 
+  /**
+   * @brief returns the kinds of the days in the period as maximal runs of consecutive days of the same kind.
+   *  The runs cover the period without gaps, including the days of kind Normal.
+   */
+  [[nodiscard]] std::vector<Entry> kind_runs(const Period& period) const;
+
+  /**
+   * @brief returns the kind runs of the sorted, non-overlapping entries and the public holidays, e.g., of a snapshot.
+   */
+  [[nodiscard]] static std::vector<Entry> kind_runs(const std::vector<Entry>& entries,
+                                                    const HolidayCalendar& holiday_calendar, const Period& period);
+
+  /**
+   * @brief returns the normal working time of each day.
+   *  The default implementation assumes that it depends on the day of the week only.
+   */
+  [[nodiscard]] virtual Schedule schedule() const;
+
+  /**
+   * @brief returns the planned working time of a day of the given kind.
+   *  The actual working time is only relevant for sick days.
+   */
+  [[nodiscard]] static std::chrono::minutes planned_working_time(Kind kind, std::chrono::minutes normal_working_time,
+                                                                 std::chrono::minutes actual_working_time) noexcept;
+
+  /**
+   * @brief returns whether the planned working time of a day of the given kind depends on its actual working time.
+   */
+  [[nodiscard]] static bool depends_on_actual_working_time(Kind kind) noexcept;
+
+  /**
+   * @brief returns whether the planned working time of days of the given kind may be obtained at once from their total
+   *  normal working time, i.e., it neither depends on the actual working time nor is rounded per day.
+   */
+  [[nodiscard]] static bool is_additive(Kind kind) noexcept;
+
+  /**
+   * @brief returns the sick, vacation and holiday leave of days of the given kind with the given normal working time.
+   *  The fractions of the normal working time are looked up in a table which is computed at compile time.
+   */
+  [[nodiscard]] static LeaveBreakdown leave(Kind kind, std::chrono::minutes normal_working_time) noexcept;
+
 Q_SIGNALS:
-  void plan_changed();
+  /**
+   * @brief emitted after entries have been added, removed or modified.
+   *  Changes made within a Transaction are reported once when the transaction ends.
+   * @param affected_period the days whose plan may have changed.
+   */
+  void plan_changed(const Period& affected_period);
 
 protected:
   [[nodiscard]] virtual std::chrono::minutes planned_normal_working_time(const QDate& date) const noexcept = 0;
 
+  /**
+   * @brief returns the sum of the normal working time of each day in the period.
+   *  The default implementation evaluates each day on its own.
+   */
+  [[nodiscard]] virtual std::chrono::minutes planned_normal_working_time(const Period& period) const noexcept;
+
 private:
   QDate m_start = Application::current_date_time().date();
   std::chrono::minutes m_overtime_offset{0};
   std::vector<std::unique_ptr<Entry>> m_periods;
-  void data_changed(int row, int column);
-  template<typename LeaveFactors> [[nodiscard]] std::chrono::minutes count(const Period& period) const;
-  [[nodiscard]] std::chrono::minutes planned_normal_working_time(const Period& period) const noexcept;
+  HolidayCalendar m_holiday_calendar;
+  std::optional<Period> m_changed_period;
+  void data_changed(int row, int column, const Period& affected_period);
+  void notify_changed(const Period& affected_period);
   [[nodiscard]] std::chrono::minutes planned_working_time(const QDate& date, Kind kind,
-                                                          const IntervalModel& interval_model) const noexcept;
+                                                          std::chrono::minutes actual_working_time) const noexcept;
   /**
    * @brief Sorts the periods.
    * The periods are supposed to be sorted at any time, i.e., this function must only be called if the ordering has
-   * been destroyed (e.g., after changing the beginning or end of a period in m_periods).
+   * been destroyed (e.g., after loading unordered periods).
+   * All other modifications keep the order using binary search and a single row move at most.
    * Sorting may fail (i.e., if periods overlap).
    * To check if sorting succeeded, use ::is_sorted.
    */
@@ -95,6 +185,27 @@ public:
   [[nodiscard]] std::chrono::minutes planned_normal_working_time(const QDate& date) const noexcept override;
 };
 
+/**
+ * @class SchedulePlan plan.h "plan.h"
+ * @brief A plan whose normal working time follows a Schedule, which is stored along with the plan.
+ *  Plans without stored schedule follow the full time schedule.
+ */
+class SchedulePlan : public Plan
+{
+public:
+  explicit SchedulePlan(const nlohmann::json& data);
+  explicit SchedulePlan(Schedule schedule);
+  [[nodiscard]] nlohmann::json to_json() const noexcept override;
+  [[nodiscard]] Schedule schedule() const override;
+
+protected:
+  [[nodiscard]] std::chrono::minutes planned_normal_working_time(const QDate& date) const noexcept override;
+  [[nodiscard]] std::chrono::minutes planned_normal_working_time(const Period& period) const noexcept override;
+
+private:
+  Schedule m_schedule;
+};
+
 template<> struct fmt::formatter<Plan::Kind> : formatter<std::string>
 {
   [[nodiscard]] static auto format(Plan::Kind kind, format_context& ctx)
@@ -26,6 +26,11 @@ const QString& Project::name() const noexcept
   return m_name;
 }
 
+Project::Id Project::id() const noexcept
+{
+  return m_id;
+}
+
 nlohmann::json Project::to_json() const
 {
   return {
@@ -39,9 +44,15 @@ const QColor& Project::color() const noexcept
   return m_color;
 }
 
+const QColor& Project::contrast_color() const noexcept
+{
+  return m_contrast_color;
+}
+
 void Project::set_color(const QColor& color) noexcept
 {
   m_color = color;
+  m_contrast_color = ::contrast_color(m_color);
 }
 
 fmt::formatter<Project>::format_return_type fmt::formatter<Project>::format(const Project& p, fmt::format_context& ctx)
@@ -1,4 +1,5 @@
 #pragma once
+#include "colorutil.h"
 #include "fmt.h"
 #include "json.h"
 
@@ -7,19 +8,35 @@
 class Project
 {
 public:
+  /**
+   * @brief The dense, zero-based position of the project in its ProjectModel.
+   *  Ids are assigned by the ProjectModel and are suitable as indices into flat tables.
+   */
+  using Id = int;
+  static constexpr Id invalid_id = -1;
+
   explicit Project(const nlohmann::json& data);
   explicit Project(QString name, const QColor& color);
   explicit Project() = default;
 
   [[nodiscard]] const QString& name() const noexcept;
+  [[nodiscard]] Id id() const noexcept;
   [[nodiscard]] nlohmann::json to_json() const;
 
   [[nodiscard]] const QColor& color() const noexcept;
+
+  /**
+   * @brief returns the color of text drawn on the project's color, which is computed when the color is set.
+   */
+  [[nodiscard]] const QColor& contrast_color() const noexcept;
   void set_color(const QColor& color) noexcept;
 
 private:
+  friend class ProjectModel;
   QString m_name;
   QColor m_color;
+  QColor m_contrast_color = ::contrast_color(m_color);
+  Id m_id = invalid_id;
 };
 
 template<> struct fmt::formatter<Project> : fmt::formatter<std::string>
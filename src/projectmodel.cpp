@@ -47,6 +47,7 @@ ProjectModel::ProjectModel()
 
 ProjectModel::ProjectModel(std::vector<std::unique_ptr<Project>> projects) : m_projects(std::move(projects))
 {
+  update_ids();
 }
 
 ProjectModel::~ProjectModel() = default;
@@ -64,30 +65,59 @@ Project& ProjectModel::add(std::unique_ptr<Project> project)
     spdlog::info("Project {} has not color. Assigning {}.", project->name(), project->color().name());
   }
   auto& ref = *m_projects.emplace_back(std::move(project));
+  index(ref, static_cast<Project::Id>(m_projects.size() - 1));
   Q_EMIT projects_changed();
   return ref;
 }
 
 std::unique_ptr<Project> ProjectModel::extract(const Project& project)
 {
-  const auto it = std::ranges::find(m_projects, &project, &std::unique_ptr<Project>::get);
+  const auto it = m_projects.begin() + project.id();
+  assert(it->get() == &project);
+  const auto renumbered = std::next(it) != m_projects.end();
   auto extracted_project = std::move(*it);
   m_projects.erase(it);
+  extracted_project->m_id = Project::invalid_id;
+  update_ids();
+  if (renumbered) {
+    Q_EMIT ids_changed();
+  }
   Q_EMIT projects_changed();
   return extracted_project;
 }
 
-const Project& ProjectModel::project(const std::size_t index) const
+const Project& ProjectModel::project(const Project::Id id) const
+{
+  return *m_projects.at(id);
+}
+
+std::size_t ProjectModel::size() const noexcept
+{
+  return m_projects.size();
+}
+
+const Project* ProjectModel::find(const QString& name) const
+{
+  if (const auto it = m_ids_by_name.find(name); it != m_ids_by_name.end()) {
+    return m_projects.at(it->second).get();
+  }
+  return nullptr;
+}
+
+void ProjectModel::update_ids()
 {
-  return *m_projects.at(index);
+  m_ids_by_name.clear();
+  for (std::size_t i = 0; i < m_projects.size(); ++i) {
+    index(*m_projects.at(i), static_cast<Project::Id>(i));
+  }
 }
 
-std::size_t ProjectModel::index_of(const Project& project) const
+void ProjectModel::index(Project& project, const Project::Id id)
 {
-  if (const auto it = std::ranges::find(m_projects, &project, &std::unique_ptr<Project>::get); it != m_projects.end()) {
-    return std::distance(m_projects.begin(), it);
+  project.m_id = id;
+  if (!m_ids_by_name.try_emplace(project.name(), id).second) {
+    spdlog::warn("Project name '{}' is not unique.", project.name());
   }
-  throw RuntimeError("Cannot find unexpected project.");
 }
 
 QColor ProjectModel::generate_color() const
@@ -2,6 +2,7 @@
 #include "project.h"
 
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 class Project;
@@ -16,13 +17,26 @@ public:
   [[nodiscard]] std::vector<Project*> projects() const;
   Project& add(std::unique_ptr<Project> project);
   std::unique_ptr<Project> extract(const Project& project);
-  [[nodiscard]] const Project& project(std::size_t index) const;
-  [[nodiscard]] std::size_t index_of(const Project& project) const;
+  [[nodiscard]] const Project& project(Project::Id id) const;
+  [[nodiscard]] std::size_t size() const noexcept;
+
+  /**
+   * @brief returns the project with the given name or nullptr if there is no such project.
+   */
+  [[nodiscard]] const Project* find(const QString& name) const;
   [[nodiscard]] QColor generate_color() const;
 
 Q_SIGNALS:
   void projects_changed();
 
+  /**
+   * @brief emitted when projects have been renumbered, i.e., ids stored elsewhere are stale.
+   */
+  void ids_changed();
+
 private:
   std::vector<std::unique_ptr<Project>> m_projects;
+  std::unordered_map<QString, Project::Id> m_ids_by_name;
+  void update_ids();
+  void index(Project& project, Project::Id id);
 };
@@ -0,0 +1,136 @@
+#include "schedule.h"
+
+#include "exceptions.h"
+#include "fmt.h"
+#include "json.h"
+#include "period.h"
+
+#include <algorithm>
+#include <nlohmann/json.hpp>
+#include <numeric>
+
+namespace
+{
+
+constexpr auto effective_from_key = "effective_from";
+constexpr auto week_key = "week";
+constexpr auto days_per_week = 7;
+
+[[nodiscard]] DayNumber effective_day(const Schedule::Contract& contract) noexcept
+{
+  // a contract without effective date becomes effective before any other.
+  return DayNumber{contract.effective_from};
+}
+
+}  // namespace
+
+void to_json(nlohmann::json& j, const Schedule::Contract& value)
+{
+  j = {{week_key, value.week}};
+  if (value.effective_from.isValid()) {
+    j[effective_from_key] = value.effective_from;
+  }
+}
+
+void from_json(const nlohmann::json& j, Schedule::Contract& value)
+{
+  value.week = j.at(week_key);
+  if (const auto it = j.find(effective_from_key); it != j.end()) {
+    value.effective_from = *it;
+  } else {
+    value.effective_from = QDate{};
+  }
+}
+
+Schedule::Schedule(std::vector<Contract> contracts) : m_contracts(std::move(contracts))
+{
+  std::ranges::sort(m_contracts, std::less<>{}, ::effective_day);
+  if (const auto it = std::ranges::adjacent_find(m_contracts, std::equal_to<>{}, ::effective_day);
+      it != m_contracts.end())
+  {
+    throw RuntimeError("Multiple contracts become effective on {}.", it->effective_from);
+  }
+
+  m_segments.reserve(m_contracts.size());
+  for (const auto& contract : m_contracts) {
+    if (std::ranges::any_of(contract.week, [](const auto minutes) { return minutes.count() < 0; })) {
+      throw RuntimeError("The contract effective from {} has a negative working time.", contract.effective_from);
+    }
+    Segment segment{.first_day = ::effective_day(contract), .week = contract.week};
+    std::partial_sum(contract.week.begin(), contract.week.end(), segment.prefix_sums.begin() + 1);
+    m_segments.push_back(segment);
+  }
+}
+
+Schedule Schedule::full_time()
+{
+  using std::chrono_literals::operator""min;
+  using std::chrono_literals::operator""h;
+  return Schedule{std::vector{Contract{.effective_from = {}, .week = {8h, 8h, 8h, 8h, 8h, 0min, 0min}}}};
+}
+
+std::chrono::minutes Schedule::working_time(const DayNumber day) const noexcept
+{
+  using std::chrono_literals::operator""min;
+  const auto it = std::ranges::upper_bound(m_segments, day, std::less<>{}, &Segment::first_day);
+  if (!day.is_valid() || it == m_segments.begin()) {
+    return 0min;
+  }
+  return std::prev(it)->week.at(day.day_of_week() - 1);
+}
+
+std::chrono::minutes Schedule::working_time(const Period& period) const noexcept
+{
+  using std::chrono_literals::operator""min;
+  const auto first_day = period.first_day();
+  const auto last_day = period.last_day();
+  if (!first_day.is_valid() || !last_day.is_valid()) {
+    return 0min;
+  }
+
+  // start with the segment which contains the first day, if any.
+  auto it = std::ranges::upper_bound(m_segments, first_day, std::less<>{}, &Segment::first_day);
+  if (it != m_segments.begin()) {
+    --it;
+  }
+  auto sum = 0min;
+  for (; it != m_segments.end() && it->first_day <= last_day; ++it) {
+    const auto next = std::next(it);
+    const auto begin = std::max(it->first_day, first_day);
+    const auto end = next == m_segments.end() ? last_day : std::min(last_day, next->first_day - 1);
+    if (begin <= end) {
+      sum += it->working_time(begin, end - begin + 1);
+    }
+  }
+  return sum;
+}
+
+const std::vector<Schedule::Contract>& Schedule::contracts() const noexcept
+{
+  return m_contracts;
+}
+
+std::chrono::minutes Schedule::Segment::working_time(const DayNumber from, const qint64 days) const noexcept
+{
+  const auto weeks = days / days_per_week;
+  const auto remainder = static_cast<int>(days % days_per_week);
+  const auto start = from.day_of_week() - 1;
+  auto sum = weeks * prefix_sums.back();
+  if (start + remainder <= days_per_week) {
+    sum += prefix_sums.at(start + remainder) - prefix_sums.at(start);
+  } else {
+    // the remaining days wrap around the end of the week.
+    sum += prefix_sums.back() - prefix_sums.at(start) + prefix_sums.at(start + remainder - days_per_week);
+  }
+  return sum;
+}
+
+void to_json(nlohmann::json& j, const Schedule& value)
+{
+  j = value.contracts();
+}
+
+void from_json(const nlohmann::json& j, Schedule& value)
+{
+  value = Schedule{j.get<std::vector<Schedule::Contract>>()};
+}
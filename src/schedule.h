@@ -0,0 +1,71 @@
+#pragma once
+
+#include "daynumber.h"
+
+#include <QDate>
+#include <array>
+#include <chrono>
+#include <nlohmann/json_fwd.hpp>
+#include <vector>
+
+class Period;
+
+/**
+ * @class Schedule schedule.h "schedule.h"
+ * @brief The normal working time of each day of the week, which may change with each new contract.
+ * A contract applies from its effective date until the next contract becomes effective. A contract without effective
+ * date applies from the beginning of time, there is no working time before the first contract otherwise.
+ * The contracts are compiled into one weekday table per segment, hence the working time of a period is computed in
+ * closed form from the number of full weeks and the remaining days of each segment it overlaps.
+ */
+class Schedule
+{
+public:
+  using Week = std::array<std::chrono::minutes, 7>;
+
+  struct Contract
+  {
+    QDate effective_from;
+
+    /**
+     * @brief the normal working time of each day of the week, starting with Monday.
+     */
+    Week week{};
+  };
+
+  explicit Schedule() = default;
+
+  /**
+   * @brief creates a schedule from the given contracts, which need not be sorted.
+   *  Throws a RuntimeError if two contracts become effective on the same day or if a working time is negative.
+   */
+  explicit Schedule(std::vector<Contract> contracts);
+
+  /**
+   * @brief returns the schedule of eight hours from Monday to Friday.
+   */
+  [[nodiscard]] static Schedule full_time();
+
+  [[nodiscard]] std::chrono::minutes working_time(DayNumber day) const noexcept;
+  [[nodiscard]] std::chrono::minutes working_time(const Period& period) const noexcept;
+  [[nodiscard]] const std::vector<Contract>& contracts() const noexcept;
+
+private:
+  struct Segment
+  {
+    DayNumber first_day;
+    Week week{};
+
+    // prefix_sums[i] is the working time from Monday to the i-th day of the week, exclusive.
+    std::array<std::chrono::minutes, 8> prefix_sums{};
+    [[nodiscard]] std::chrono::minutes working_time(DayNumber from, qint64 days) const noexcept;
+  };
+
+  std::vector<Contract> m_contracts;
+  std::vector<Segment> m_segments;
+};
+
+void to_json(nlohmann::json& j, const Schedule::Contract& value);
+void from_json(const nlohmann::json& j, Schedule::Contract& value);
+void to_json(nlohmann::json& j, const Schedule& value);
+void from_json(const nlohmann::json& j, Schedule& value);
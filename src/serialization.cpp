@@ -1,10 +1,23 @@
 #include "serialization.h"
+#include "aggregation.h"
+#include "application.h"
 #include "exceptions.h"
 #include "intervalmodel.h"
+#include "isodate.h"
+#include "jsonwriter.h"
 #include "plan.h"
 #include "projectmodel.h"
 #include "timesheet.h"
+#include <QFile>
+#include <QThreadPool>
+#include <bitset>
+#include <fstream>
+#include <latch>
+#include <map>
 #include <nlohmann/json.hpp>
+#include <optional>
+#include <ranges>
+#include <set>
 #include <spdlog/spdlog.h>
 
 namespace
@@ -21,64 +34,430 @@ constexpr auto plan_key = "plan";
 constexpr auto project_key = "project";
 constexpr auto begin_key = "begin";
 constexpr auto end_key = "end";
+constexpr auto segments_key = "segments";
+constexpr auto year_key = "year";
+constexpr auto file_key = "file";
+constexpr auto totals_key = "totals";
+constexpr auto carry_over_key = "carry_over";
 
-using ProjectIndexMap = std::map<const Project*, int>;
+struct SegmentReference
+{
+  int year;
+  std::filesystem::path filename;
+  Aggregation::Totals totals;
+  std::chrono::milliseconds carry_over;
+};
+
+void write_interval(JsonWriter& writer, const Interval& interval)
+{
+  writer.begin_object();
+  writer.key(begin_key);
+  writer.value(interval.begin());
+  writer.key(end_key);
+  writer.value(interval.end());
+  writer.key(project_key);
+  if (const auto project = interval.project(); project == nullptr) {
+    writer.value(nullptr);
+  } else if (project->id() == Project::invalid_id) {
+    throw DeserializationError("Failed to store project reference.");
+  } else {
+    writer.value(project->id());
+  }
+  writer.end_object();
+}
+
+void write_intervals(JsonWriter& writer, const auto& intervals)
+{
+  writer.begin_array();
+  for (const auto* const interval : intervals) {
+    ::write_interval(writer, *interval);
+  }
+  writer.end_array();
+}
 
-[[nodiscard]] auto create_project_index_map(const std::vector<Project*>& projects)
+void write_time_sheet(JsonWriter& writer, const TimeSheet& time_sheet, const auto& intervals,
+                      const std::vector<SegmentReference>& segments)
 {
-  ProjectIndexMap map;
-  for (const auto* const project : projects) {
-    map.try_emplace(project, static_cast<int>(map.size()));
+  // the keys are written in lexicographical order, as nlohmann::json does.
+  writer.begin_object();
+  writer.key(interval_model_key);
+  ::write_intervals(writer, intervals);
+  writer.key(plan_key);
+  writer.document(time_sheet.plan().to_json());
+  writer.key(project_model_key);
+  writer.begin_array();
+  for (const auto* const project : time_sheet.project_model().projects()) {
+    writer.document(project->to_json());
   }
-  return map;
+  writer.end_array();
+  writer.key(segments_key);
+  writer.begin_array();
+  for (const auto& segment : segments) {
+    writer.begin_object();
+    writer.key(carry_over_key);
+    writer.value(segment.carry_over.count());
+    writer.key(file_key);
+    writer.value(segment.filename.filename().string());
+    writer.key(totals_key);
+    writer.document(segment.totals);
+    writer.key(year_key);
+    writer.value(segment.year);
+    writer.end_object();
+  }
+  writer.end_array();
+  writer.end_object();
 }
 
-[[nodiscard]] auto serialize(const IntervalModel& interval_model, const ProjectIndexMap& project_index_map)
+/**
+ * @brief An interval as stored in a file, the project is referenced by its index.
+ */
+struct IntervalRecord
+{
+  QDateTime begin;
+  QDateTime end;
+  std::optional<std::size_t> project;
+};
+
+/**
+ * @brief A time sheet file whose intervals are decoded while parsing, see TimeSheetReader.
+ */
+struct Document
 {
-  std::list<nlohmann::json> vs;
-  for (const auto* const interval : interval_model.intervals()) {
-    nlohmann::json& j = vs.emplace_back();
-    j[begin_key] = interval->begin();
-    j[end_key] = interval->end();
-    if (const auto project = interval->project(); project == nullptr) {
-      j[project_key] = nullptr;
+  nlohmann::json data;
+  std::optional<std::vector<IntervalRecord>> intervals;
+};
+
+[[nodiscard]] QDateTime parse_date_time(const std::string& text)
+{
+  if (const auto date_time = ::parse_iso_date_time(text); date_time.has_value()) {
+    return *date_time;
+  }
+  return QDateTime::fromString(QString::fromStdString(text), Qt::ISODate);
+}
+
+/**
+ * @brief Parses a time sheet or segment file without building the document of its intervals.
+ *  The intervals make up most of a file. Their timestamps are decoded from the parsed strings right away and their
+ *  project references are kept as indices, since the projects follow the intervals in the file.
+ *  All other values are collected in a document, as nlohmann::json::parse does.
+ */
+class TimeSheetReader final : public nlohmann::json_sax<nlohmann::json>
+{
+public:
+  [[nodiscard]] Document take() noexcept
+  {
+    return {std::move(m_data), std::move(m_intervals)};
+  }
+
+  bool null() override
+  {
+    if (m_state == State::Interval) {
+      set_project(std::nullopt);
+      return true;
+    }
+    return add(nullptr);
+  }
+
+  bool boolean(const bool value) override
+  {
+    return m_state == State::Interval ? reject() : add(value);
+  }
+
+  bool number_integer(const number_integer_t value) override
+  {
+    if (m_state == State::Interval) {
+      if (value < 0) {
+        return reject();
+      }
+      set_project(static_cast<std::size_t>(value));
+      return true;
+    }
+    return add(value);
+  }
+
+  bool number_unsigned(const number_unsigned_t value) override
+  {
+    if (m_state == State::Interval) {
+      set_project(static_cast<std::size_t>(value));
+      return true;
+    }
+    return add(value);
+  }
+
+  bool number_float(const number_float_t value, const string_t&) override
+  {
+    return m_state == State::Interval ? reject() : add(value);
+  }
+
+  bool string(string_t& value) override
+  {
+    if (m_state == State::Interval) {
+      set_timestamp(value);
+      return true;
+    }
+    return add(std::move(value));
+  }
+
+  bool binary(binary_t& value) override
+  {
+    return m_state == State::Interval ? reject() : add(std::move(value));
+  }
+
+  bool start_object(std::size_t) override
+  {
+    switch (m_state) {
+    case State::Intervals:
+      m_state = State::Interval;
+      m_interval = {};
+      m_interval_keys.reset();
+      return true;
+    case State::Interval:
+      return skip();
+    case State::Document:
+      m_stack.emplace_back(&add_value(nlohmann::json::object()));
+      return true;
+    }
+    Q_UNREACHABLE();
+  }
+
+  bool key(string_t& key) override
+  {
+    if (m_state == State::Interval) {
+      if (m_skipped_depth == 0) {
+        m_interval_key = std::move(key);
+      }
     } else {
-      try {
-        j[project_key] = project_index_map.at(project);
-      } catch (std::out_of_range&) {
-        throw DeserializationError("Failed to store project reference.");
+      m_is_interval_array_next = m_stack.size() == 1 && key == interval_model_key;
+      m_key = std::move(key);
+    }
+    return true;
+  }
+
+  bool end_object() override
+  {
+    if (m_state == State::Document) {
+      m_stack.pop_back();
+    } else if (m_skipped_depth > 0) {
+      m_skipped_depth -= 1;
+    } else {
+      for (std::size_t i = 0; i < interval_keys.size(); ++i) {
+        if (!m_interval_keys.test(i)) {
+          throw DeserializationError("Failed to restore interval: missing '{}'.", interval_keys.at(i));
+        }
+      }
+      m_intervals->emplace_back(std::move(m_interval));
+      m_state = State::Intervals;
+    }
+    return true;
+  }
+
+  bool start_array(std::size_t) override
+  {
+    switch (m_state) {
+    case State::Intervals:
+      throw DeserializationError("Failed to restore interval: expected an object.");
+    case State::Interval:
+      return skip();
+    case State::Document:
+      if (std::exchange(m_is_interval_array_next, false)) {
+        m_intervals.emplace();
+        m_state = State::Intervals;
+      } else {
+        m_stack.emplace_back(&add_value(nlohmann::json::array()));
       }
+      return true;
+    }
+    Q_UNREACHABLE();
+  }
+
+  bool end_array() override
+  {
+    if (m_state == State::Document) {
+      m_stack.pop_back();
+    } else if (m_state == State::Intervals) {
+      m_state = State::Document;
+    } else {
+      m_skipped_depth -= 1;
+    }
+    return true;
+  }
+
+  bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& e) override
+  {
+    ::throw_as_deserialization_error(e);
+  }
+
+private:
+  enum class State { Document, Intervals, Interval };
+  static constexpr std::array interval_keys{begin_key, end_key, project_key};
+  State m_state = State::Document;
+
+  // the document of the values other than the intervals and its objects and arrays which are being parsed.
+  nlohmann::json m_data;
+  std::vector<nlohmann::json*> m_stack;
+  std::string m_key;
+  bool m_is_interval_array_next = false;
+
+  // the intervals, the interval which is being parsed, its keys and the depth of values of unknown keys in it.
+  std::optional<std::vector<IntervalRecord>> m_intervals;
+  IntervalRecord m_interval;
+  std::string m_interval_key;
+  std::bitset<interval_keys.size()> m_interval_keys;
+  std::size_t m_skipped_depth = 0;
+
+  [[nodiscard]] nlohmann::json& add_value(nlohmann::json value)
+  {
+    if (m_state == State::Intervals) {
+      throw DeserializationError("Failed to restore interval: expected an object.");
+    }
+    if (std::exchange(m_is_interval_array_next, false)) {
+      throw DeserializationError("Failed to load time sheet: '{}' is not an array.", interval_model_key);
+    }
+    if (m_stack.empty()) {
+      return m_data = std::move(value);
+    }
+    auto& parent = *m_stack.back();
+    return parent.is_array() ? parent.emplace_back(std::move(value)) : (parent[m_key] = std::move(value));
+  }
+
+  bool add(nlohmann::json value)
+  {
+    static_cast<void>(add_value(std::move(value)));
+    return true;
+  }
+
+  /**
+   * @brief returns the index of the current key in interval_keys, if it is a key of the interval itself.
+   */
+  [[nodiscard]] std::optional<std::size_t> interval_key() const noexcept
+  {
+    const auto it = std::ranges::find(interval_keys, m_interval_key);
+    if (m_skipped_depth > 0 || it == interval_keys.end()) {
+      return std::nullopt;
+    }
+    return static_cast<std::size_t>(std::distance(interval_keys.begin(), it));
+  }
+
+  bool reject() const
+  {
+    if (interval_key().has_value()) {
+      throw DeserializationError("Failed to restore interval: invalid value of '{}'.", m_interval_key);
+    }
+    return true;
+  }
+
+  bool skip()
+  {
+    reject();
+    m_skipped_depth += 1;
+    return true;
+  }
+
+  void set_project(const std::optional<std::size_t>& project)
+  {
+    if (const auto key = interval_key(); key.has_value() && interval_keys.at(*key) == project_key) {
+      m_interval.project = project;
+      m_interval_keys.set(*key);
+    } else {
+      reject();
+    }
+  }
+
+  void set_timestamp(const std::string& text)
+  {
+    if (const auto key = interval_key(); key.has_value() && interval_keys.at(*key) != project_key) {
+      (interval_keys.at(*key) == begin_key ? m_interval.begin : m_interval.end) = ::parse_date_time(text);
+      m_interval_keys.set(*key);
+    } else {
+      reject();
+    }
+  }
+};
+
+[[nodiscard]] std::vector<std::unique_ptr<Interval>> make_intervals(const std::vector<IntervalRecord>& records,
+                                                                    const std::vector<Project*>& projects)
+{
+  std::vector<std::unique_ptr<Interval>> intervals;
+  intervals.reserve(records.size());
+  for (const auto& [begin, end, project] : records) {
+    if (project.has_value() && *project >= projects.size()) {
+      throw DeserializationError("Failed to restore project reference.");
     }
+    auto& interval = *intervals.emplace_back(
+        std::make_unique<Interval>(project.has_value() ? projects.at(*project) : nullptr));
+    interval.swap_begin(begin);
+    interval.swap_end(end);
   }
-  return vs;
+  return intervals;
 }
 
-[[nodiscard]] auto serialize(const ProjectModel& project_model)
+[[nodiscard]] std::unique_ptr<Interval> deserialize_interval(const nlohmann::json& data,
+                                                             const std::vector<Project*>& projects)
 {
-  std::list<nlohmann::json> vs;
-  for (const auto* const project : project_model.projects()) {
-    vs.emplace_back(project->to_json());
+  try {
+    const auto& project_reference = data.at(project_key);
+    const auto* const project = project_reference.is_null() ? nullptr
+                                                            : projects.at(project_reference.get<std::size_t>());
+    auto interval = std::make_unique<Interval>(project);
+    interval->swap_begin(data.at(begin_key));
+    interval->swap_end(data.at(end_key));
+    return interval;
+  } catch (const std::out_of_range&) {
+    throw DeserializationError("Failed to restore project reference.");
+  } catch (const nlohmann::json::exception& e) {
+    throw DeserializationError("Failed to restore interval: {}", e.what());
   }
-  return vs;
 }
 
-[[nodiscard]] auto deserialize_interval_model(const nlohmann::json& data, const std::vector<Project*>& projects)
+[[nodiscard]] auto deserialize_intervals(const nlohmann::json& data, const std::vector<Project*>& projects)
 {
-  std::deque<std::unique_ptr<Interval>> intervals;
+  std::vector<const nlohmann::json*> values;
+  values.reserve(data.size());
   for (const auto& v : data) {
+    values.emplace_back(&v);
+  }
+
+  // The intervals are decoded in chunks on the thread pool. Each chunk stops at its first error, the error of the
+  // earliest interval is reported, i.e., the same one as if the intervals were decoded sequentially.
+  static constexpr std::size_t chunk_size = 1024;
+  const auto chunk_count = (values.size() + chunk_size - 1) / chunk_size;
+  std::vector<std::unique_ptr<Interval>> intervals(values.size());
+  std::vector<std::exception_ptr> errors(chunk_count);
+  const auto decode_chunk = [&](const std::size_t chunk) {
     try {
-      const auto project_reference = v.at(project_key);
-      const auto* const project = project_reference.is_null() ? nullptr : projects.at(project_reference);
-      auto& interval = *intervals.emplace_back(std::make_unique<Interval>(project));
-      interval.swap_begin(v.at(begin_key));
-      interval.swap_end(v.at(end_key));
-    } catch (const std::out_of_range&) {
-      throw DeserializationError("Failed to restore project reference.");
-    } catch (const nlohmann::json::exception&) {
-      throw DeserializationError("Failed to restore project reference.");
+      for (auto i = chunk * chunk_size; i < std::min(values.size(), (chunk + 1) * chunk_size); ++i) {
+        intervals.at(i) = ::deserialize_interval(*values.at(i), projects);
+      }
+    } catch (...) {
+      errors.at(chunk) = std::current_exception();
     }
+  };
+
+  if (chunk_count == 1) {
+    decode_chunk(0);
+  } else {
+    std::latch done{static_cast<std::ptrdiff_t>(chunk_count)};
+    for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+      QThreadPool::globalInstance()->start([&decode_chunk, &done, chunk]() {
+        decode_chunk(chunk);
+        done.count_down();
+      });
+    }
+    done.wait();
+  }
+
+  if (const auto it = std::ranges::find_if(errors, [](const auto& error) { return error != nullptr; });
+      it != errors.end())
+  {
+    std::rethrow_exception(*it);
   }
-  return std::make_unique<IntervalModel>(std::move(intervals));
+  return intervals;
+}
+
+[[nodiscard]] auto make_interval_model(std::vector<std::unique_ptr<Interval>> intervals)
+{
+  return std::make_unique<IntervalModel>(std::deque<std::unique_ptr<Interval>>{
+      std::make_move_iterator(intervals.begin()), std::make_move_iterator(intervals.end())});
 }
 
 [[nodiscard]] auto deserialize_project_model(const nlohmann::json& data)
@@ -99,25 +478,52 @@ using ProjectIndexMap = std::map<const Project*, int>;
   }
 }
 
-}  // namespace
+[[nodiscard]] Document parse(const auto begin, const auto end)
+{
+  TimeSheetReader reader;
+  try {
+    nlohmann::json::sax_parse(begin, end, &reader);
+  } catch (const nlohmann::json::exception& e) {
+    ::throw_as_deserialization_error(e);
+  }
+  return reader.take();
+}
 
-nlohmann::json serialize(const TimeSheet& time_sheet)
+[[nodiscard]] Document read(const std::filesystem::path& filename)
 {
-  nlohmann::json j;
-  j[project_model_key] = serialize(time_sheet.project_model());
-  j[interval_model_key] =
-      serialize(time_sheet.interval_model(), ::create_project_index_map(time_sheet.project_model().projects()));
-  j[plan_key] = time_sheet.plan().to_json();
-  return j;
+  QFile file(QString::fromStdString(filename.string()));
+  if (!file.open(QIODevice::ReadOnly)) {
+    throw DeserializationError("Failed to open '{}' for reading.", filename.string());
+  }
+
+  // The parser reads the mapped pages directly, the file is not copied through stream buffers.
+  // Files which cannot be mapped (e.g., empty files or pipes) are read as a whole instead.
+  if (const auto size = file.size(); size > 0) {
+    if (const auto* const data = file.map(0, size); data != nullptr) {
+      return ::parse(data, data + size);
+    }
+  }
+  const auto bytes = file.readAll();
+  return ::parse(bytes.begin(), bytes.end());
 }
 
-std::unique_ptr<TimeSheet> deserialize(const nlohmann::json& json)
+[[nodiscard]] const std::vector<IntervalRecord>& intervals(const Document& document)
+{
+  if (!document.intervals.has_value()) {
+    throw DeserializationError("Failed to load time sheet: missing '{}'.", interval_model_key);
+  }
+  return *document.intervals;
+}
+
+/**
+ * @brief restores the time sheet from the given document and the intervals made for the restored projects.
+ */
+[[nodiscard]] std::unique_ptr<TimeSheet> restore_time_sheet(const nlohmann::json& json, const auto& make_intervals)
 {
   try {
     auto project_model = ::deserialize_project_model(json.at(project_model_key));
-    const auto projects = project_model->projects();
-    auto interval_model = ::deserialize_interval_model(json.at(interval_model_key), projects);
-    auto plan = std::make_unique<FullTimePlan>(json.at(plan_key));
+    auto interval_model = ::make_interval_model(make_intervals(project_model->projects()));
+    auto plan = std::make_unique<SchedulePlan>(json.at(plan_key));
     return std::make_unique<TimeSheet>(std::move(project_model), std::move(interval_model), std::move(plan));
   } catch (const nlohmann::json::out_of_range& e) {
     ::throw_as_deserialization_error(e);
@@ -125,3 +531,180 @@ std::unique_ptr<TimeSheet> deserialize(const nlohmann::json& json)
     ::throw_as_deserialization_error(e);
   }
 }
+
+void write_file(const std::filesystem::path& filename, const auto& write)
+{
+  std::ofstream ofs(filename);
+  if (!ofs) {
+    throw RuntimeError("Failed to open '{}' for writing.", filename.string());
+  }
+  JsonWriter writer{ofs};
+  write(writer);
+  if (!ofs.flush()) {
+    throw RuntimeError("Failed to write '{}'.", filename.string());
+  }
+}
+
+[[nodiscard]] std::chrono::milliseconds carry_over(const std::vector<const Interval*>& intervals, const int year)
+{
+  const auto next_year = QDate{year + 1, 1, 1}.startOfDay();
+  std::chrono::milliseconds carry_over{0};
+  for (const auto* const interval : intervals) {
+    if (interval->end() > next_year) {
+      carry_over += std::chrono::milliseconds{std::max(interval->begin(), next_year).msecsTo(interval->end())};
+    }
+  }
+  return carry_over;
+}
+
+[[nodiscard]] std::filesystem::path segment_filename(const std::filesystem::path& filename, const int year)
+{
+  auto segment_filename = filename;
+  segment_filename.replace_filename(fmt::format("{}.{}{}", filename.stem().string(), year,
+                                                filename.extension().string()));
+  return segment_filename;
+}
+
+}  // namespace
+
+void serialize(const TimeSheet& time_sheet, std::ostream& out)
+{
+  JsonWriter writer{out};
+  ::write_time_sheet(writer, time_sheet, time_sheet.interval_model().intervals(), {});
+}
+
+std::unique_ptr<TimeSheet> deserialize(const nlohmann::json& json)
+{
+  return ::restore_time_sheet(json, [&json](const std::vector<Project*>& projects) {
+    try {
+      return ::deserialize_intervals(json.at(interval_model_key), projects);
+    } catch (const nlohmann::json::out_of_range& e) {
+      ::throw_as_deserialization_error(e);
+    }
+  });
+}
+
+void save(TimeSheet& time_sheet, const std::filesystem::path& filename)
+{
+  // Closed intervals are stored with the year they begin in. Open intervals always stay in the main file.
+  const auto current_year = Application::current_date_time().date().year();
+  const auto segment_year = [current_year](const Interval& interval) -> std::optional<int> {
+    if (const auto year = interval.begin().date().year();
+        interval.begin().isValid() && interval.end().isValid() && year < current_year)
+    {
+      return year;
+    }
+    return std::nullopt;
+  };
+
+  // Intervals may have been added to a year whose segment failed to load on demand. Rewriting its segment file
+  // would lose the intervals stored there, hence the segment must be loaded first.
+  std::set<int> years_to_load;
+  for (const auto* const interval : time_sheet.interval_model().intervals()) {
+    if (const auto year = segment_year(*interval);
+        year.has_value() && time_sheet.unloaded_segments().contains(*year))
+    {
+      years_to_load.insert(*year);
+    }
+  }
+  for (const auto year : years_to_load) {
+    try {
+      time_sheet.load_segments(Period{QDate{year, 1, 1}, QDate{year, 12, 31}});
+    } catch (const DeserializationError& e) {
+      throw RuntimeError("The intervals of {} cannot be loaded and would be overwritten: {}", year, e.what());
+    }
+  }
+
+  std::vector<const Interval*> recent_intervals;
+  std::map<int, std::vector<const Interval*>> past_intervals;
+  for (const auto* const interval : time_sheet.interval_model().intervals()) {
+    if (const auto year = segment_year(*interval); year.has_value()) {
+      past_intervals[*year].emplace_back(interval);
+    } else {
+      recent_intervals.emplace_back(interval);
+    }
+  }
+  assert(std::ranges::none_of(past_intervals | std::views::keys, [&time_sheet](const auto year) {
+    return time_sheet.unloaded_segments().contains(year);
+  }));
+
+  std::vector<SegmentReference> segments;
+  for (const auto& [year, segment] : time_sheet.unloaded_segments()) {
+    // the segment file lives next to the file it was loaded from, which differs when saving under a new name.
+    const auto segment_filename = ::segment_filename(filename, year);
+    if (segment.filename != segment_filename) {
+      try {
+        std::filesystem::copy_file(segment.filename, segment_filename,
+                                   std::filesystem::copy_options::overwrite_existing);
+      } catch (const std::filesystem::filesystem_error& e) {
+        throw RuntimeError("Failed to copy '{}': {}", segment.filename.string(), e.what());
+      }
+    }
+    segments.push_back({year, segment_filename, segment.totals, segment.carry_over});
+  }
+
+  if (!past_intervals.empty()) {
+    const auto& plan_start = time_sheet.plan().start();
+    const Period history{QDate{past_intervals.begin()->first, 1, 1}, QDate{current_year, 1, 1}.addDays(-1)};
+    const Aggregation aggregation{time_sheet.snapshot(), history, *QThreadPool::globalInstance()};
+    for (const auto& [year, intervals] : past_intervals) {
+      const auto segment_filename = ::segment_filename(filename, year);
+      ::write_file(segment_filename, [&intervals](JsonWriter& writer) {
+        writer.begin_object();
+        writer.key(interval_model_key);
+        ::write_intervals(writer, intervals);
+        writer.end_object();
+      });
+      const Period accounted_days{std::max(QDate{year, 1, 1}, plan_start), QDate{year + 1, 1, 1}.addDays(-1)};
+      auto totals = plan_start.year() > year ? Aggregation::Totals{} : aggregation.totals(accounted_days);
+      // the intervals of an unloaded previous year are missing in the aggregation.
+      if (const auto previous = time_sheet.unloaded_segments().find(year - 1);
+          previous != time_sheet.unloaded_segments().end() && accounted_days.contains(QDate{year, 1, 1}))
+      {
+        totals.actual += previous->second.carry_over;
+      }
+      segments.push_back({year, segment_filename, totals, ::carry_over(intervals, year)});
+    }
+  }
+
+  ::write_file(filename, [&](JsonWriter& writer) {
+    ::write_time_sheet(writer, time_sheet, recent_intervals, segments);
+  });
+}
+
+std::unique_ptr<TimeSheet> load(const std::filesystem::path& filename)
+{
+  const auto document = ::read(filename);
+  const auto& data = document.data;
+  auto time_sheet = ::restore_time_sheet(data, [&document](const std::vector<Project*>& projects) {
+    return ::make_intervals(::intervals(document), projects);
+  });
+  if (!data.contains(segments_key)) {
+    return time_sheet;
+  }
+
+  try {
+    std::map<int, TimeSheet::Segment> segments;
+    for (const auto& v : data.at(segments_key)) {
+      segments.emplace(v.at(year_key).get<int>(),
+                       TimeSheet::Segment{
+                           .filename = filename.parent_path() / v.at(file_key).get<std::string>(),
+                           .totals = v.at(totals_key),
+                           .carry_over = std::chrono::milliseconds{v.value(carry_over_key, std::int64_t{0})},
+                       });
+    }
+    time_sheet->set_unloaded_segments(std::move(segments));
+  } catch (const nlohmann::json::exception& e) {
+    ::throw_as_deserialization_error(e);
+  }
+
+  const auto today = Application::current_date_time().date();
+  time_sheet->load_segments(Period{QDate{today.year(), 1, 1}, today});
+  return time_sheet;
+}
+
+std::vector<std::unique_ptr<Interval>> load_segment(const std::filesystem::path& filename,
+                                                    const ProjectModel& project_model)
+{
+  return ::make_intervals(::intervals(::read(filename)), project_model.projects());
+}
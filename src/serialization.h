@@ -1,7 +1,41 @@
 #pragma once
 #include "json.h"
 
+#include <filesystem>
+#include <iosfwd>
+#include <memory>
+#include <vector>
+
+class Interval;
+class ProjectModel;
 class TimeSheet;
 
-[[nodiscard]] nlohmann::json serialize(const TimeSheet& time_sheet);
-[[nodiscard]] std::unique_ptr<TimeSheet> deserialize(const nlohmann::json& json);
\ No newline at end of file
+/**
+ * @brief writes all loaded intervals, projects and the plan as a single document in one pass over the models.
+ *  The output is the compact JSON of nlohmann::json, it is accepted by deserialize.
+ */
+void serialize(const TimeSheet& time_sheet, std::ostream& out);
+[[nodiscard]] std::unique_ptr<TimeSheet> deserialize(const nlohmann::json& json);
+
+/**
+ * @brief writes the time sheet to the given file.
+ *  The closed intervals of past years are written to one segment file per year next to it, e.g., `sheet.2023.ts`.
+ *  The main file references the segments along with their totals, and holds projects, plan and recent intervals.
+ *  Unloaded segments whose year has loaded intervals are loaded first, since their file is rewritten.
+ * @throws RuntimeError if any of the files cannot be written or if such a segment cannot be loaded.
+ */
+void save(TimeSheet& time_sheet, const std::filesystem::path& filename);
+
+/**
+ * @brief reads the time sheet from the given file.
+ *  Only the recent segments are loaded, the others are loaded on demand, @see TimeSheet::load_segments.
+ * @throws DeserializationError if the file cannot be read.
+ */
+[[nodiscard]] std::unique_ptr<TimeSheet> load(const std::filesystem::path& filename);
+
+/**
+ * @brief reads the intervals of a segment file written by save.
+ * @throws DeserializationError if the file cannot be read.
+ */
+[[nodiscard]] std::vector<std::unique_ptr<Interval>> load_segment(const std::filesystem::path& filename,
+                                                                  const ProjectModel& project_model);
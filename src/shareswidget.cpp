@@ -15,11 +15,11 @@ SharesWidget::SharesWidget(QWidget* parent) : QWidget(parent)
 void SharesWidget::update(const TimeSheet& time_sheet, const Period& period)
 {
   m_shares.clear();
-  const auto& interval_model = time_sheet.interval_model();
+  const auto daily_minutes = time_sheet.interval_model().daily_minutes(period);
   double total = 0.0;
   for (const auto& project : time_sheet.project_model().projects()) {
     using std::chrono_literals::operator""min;
-    const auto d = interval_model.minutes(period, project->name()) / 1.min;
+    const auto d = daily_minutes.minutes(project->id()) / 1.min;
     m_shares.emplace_back(project, d);
     total += d;
   }
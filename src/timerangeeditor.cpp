@@ -13,14 +13,11 @@ TimeRangeEditor::TimeRangeEditor(const IntervalModel& interval_model, QWidget* c
   m_ui->setupUi(this);
   connect(m_ui->cb_has_end, &QCheckBox::toggled, this, &TimeRangeEditor::update_enabledness);
   connect(m_ui->pb_begin_to_last_end, &QPushButton::clicked, this, [&interval_model, this]() {
-    auto ends_view =
-        interval_model.intervals() | std::views::transform(&Interval::end) | std::views::filter(&QDateTime::isValid);
-    if (const std::vector ends(ends_view.begin(), ends_view.end()); ends.empty()) {
+    if (const auto end = interval_model.last_end(); !end.isValid()) {
       QMessageBox::critical(this, "Error", "No end intervals were found");
     } else {
-      const auto end = std::ranges::max_element(ends);
-      m_ui->de_begin->setDate(end->date());
-      m_ui->te_begin->set_time(end->time());
+      m_ui->de_begin->setDate(end.date());
+      m_ui->te_begin->set_time(end.time());
     }
   });
   connect(m_ui->pb_begin_to_now, &QPushButton::clicked, this, [this]() {
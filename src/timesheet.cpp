@@ -1,21 +1,161 @@
 #include "timesheet.h"
 
+#include "exceptions.h"
 #include "intervalmodel.h"
 #include "period.h"
 #include "plan.h"
 #include "projectmodel.h"
+#include "serialization.h"
+
+#include <spdlog/spdlog.h>
 
 TimeSheet::TimeSheet()
   : m_project_model(std::make_unique<ProjectModel>())
   , m_interval_model(std::make_unique<IntervalModel>())
-  , m_plan(std::make_unique<FullTimePlan>())
+  , m_plan(std::make_unique<SchedulePlan>(Schedule::full_time()))
 {
+  track_changes();
+  load_segments_on_demand();
 }
 
 TimeSheet::TimeSheet(std::unique_ptr<ProjectModel> project_model, std::unique_ptr<IntervalModel> interval_model,
                      std::unique_ptr<Plan> plan)
   : m_project_model(std::move(project_model)), m_interval_model(std::move(interval_model)), m_plan(std::move(plan))
 {
+  track_changes();
+  load_segments_on_demand();
+}
+
+void TimeSheet::track_changes()
+{
+  // The models are owned by this time sheet, hence they are suitable as context objects.
+  auto* const interval_model = m_interval_model.get();
+  QObject::connect(interval_model, &IntervalModel::dataChanged, interval_model,
+                   [this](const QModelIndex& top_left, const QModelIndex& bottom_right) {
+                     mark_changed_rows(top_left.row(), bottom_right.row());
+                   });
+  QObject::connect(interval_model, &IntervalModel::rowsInserted, interval_model,
+                   [this](const QModelIndex&, const int first, const int last) { mark_changed_rows(first, last); });
+  QObject::connect(interval_model, &IntervalModel::rows_reassigned, interval_model,
+                   [this](const std::vector<int>& rows) {
+                     for (const auto row : rows) {
+                       mark_changed_rows(row, row);
+                     }
+                   });
+  QObject::connect(interval_model, &IntervalModel::rowsRemoved, interval_model,
+                   [this](const QModelIndex&, const int first, const int last) {
+                     // only the last rows are removed, no other row moves.
+                     mark_changed_rows(first, last);
+                   });
+  QObject::connect(interval_model, &IntervalModel::modelReset, interval_model,
+                   [this]() { m_changes.all_intervals = true; });
+
+  const auto mark_plan_changed = [this]() { m_changes.plan = true; };
+  QObject::connect(m_plan.get(), &Plan::dataChanged, m_plan.get(), mark_plan_changed);
+  QObject::connect(m_plan.get(), &Plan::rowsInserted, m_plan.get(), mark_plan_changed);
+  QObject::connect(m_plan.get(), &Plan::rowsRemoved, m_plan.get(), mark_plan_changed);
+  QObject::connect(m_plan.get(), &Plan::modelReset, m_plan.get(), mark_plan_changed);
+  QObject::connect(m_project_model.get(), &ProjectModel::projects_changed, m_project_model.get(),
+                   [this]() { m_changes.projects = true; });
+  // the interval records refer to projects by id.
+  QObject::connect(m_project_model.get(), &ProjectModel::ids_changed, m_project_model.get(),
+                   [this]() { m_changes.all_intervals = true; });
+}
+
+void TimeSheet::load_segments_on_demand()
+{
+  const auto load = [this](const Period& affected_period) {
+    try {
+      load_segments(affected_period);
+    } catch (const DeserializationError& e) {
+      spdlog::error("{}", e.what());
+    }
+  };
+  QObject::connect(m_plan.get(), &Plan::plan_changed, m_plan.get(), load);
+  QObject::connect(m_interval_model.get(), &IntervalModel::data_changed, m_interval_model.get(), load);
+}
+
+void TimeSheet::mark_changed_rows(const int first, const int last)
+{
+  if (m_changes.all_intervals) {
+    return;
+  }
+  const auto first_chunk = static_cast<std::size_t>(first) / TimeSheetSnapshot::chunk_size;
+  const auto last_chunk = static_cast<std::size_t>(last) / TimeSheetSnapshot::chunk_size;
+  for (auto chunk = first_chunk; chunk <= last_chunk; ++chunk) {
+    m_changes.interval_chunks.insert(chunk);
+  }
+}
+
+std::shared_ptr<const TimeSheetSnapshot> TimeSheet::snapshot() const
+{
+  if (!m_changes.empty()) {
+    m_snapshot = std::make_shared<const TimeSheetSnapshot>(*this, *m_snapshot, m_changes);
+    m_changes = TimeSheetSnapshot::Changes{
+        .all_intervals = false,
+        .interval_chunks = {},
+        .plan = false,
+        .projects = false,
+    };
+  }
+  return m_snapshot;
+}
+
+const std::map<int, TimeSheet::Segment>& TimeSheet::unloaded_segments() const noexcept
+{
+  return m_unloaded_segments;
+}
+
+void TimeSheet::set_unloaded_segments(std::map<int, Segment> segments)
+{
+  m_unloaded_segments = std::move(segments);
+}
+
+void TimeSheet::load_segments(const Period& period)
+{
+  // intervals are stored with the year they begin in, hence the previous year may extend into the period.
+  const auto first = m_unloaded_segments.lower_bound(period.begin().year() - 1);
+  const auto last = m_unloaded_segments.upper_bound(period.end().year());
+  if (first == last) {
+    return;
+  }
+
+  // load all segments before touching the model, so a failure leaves the time sheet unchanged.
+  std::vector<std::unique_ptr<Interval>> intervals;
+  for (auto it = first; it != last; ++it) {
+    std::ranges::move(::load_segment(it->second.filename, *m_project_model), std::back_inserter(intervals));
+  }
+  m_unloaded_segments.erase(first, last);
+  m_interval_model->add(std::move(intervals));
+}
+
+Aggregation::Totals TimeSheet::totals(const Aggregation& aggregation, const Period& period) const
+{
+  Aggregation::Totals totals;
+  auto begin = period.begin();
+  for (const auto& [year, segment] : m_unloaded_segments) {
+    const QDate first_day{year, 1, 1};
+    const auto last_day = first_day.addYears(1).addDays(-1);
+    if (last_day < begin || first_day > period.end()) {
+      continue;
+    }
+    if (begin < first_day) {
+      totals += aggregation.totals(Period{begin, first_day.addDays(-1)});
+    }
+    totals += segment.totals;
+    begin = last_day.addDays(1);
+  }
+  if (begin <= period.end()) {
+    totals += aggregation.totals(Period{begin, period.end()});
+  }
+
+  // the totals of an unloaded year include the time carried over from the previous year already.
+  for (const auto& [year, segment] : m_unloaded_segments) {
+    if (!m_unloaded_segments.contains(year + 1) && period.contains(QDate{year + 1, 1, 1})) {
+      totals.actual += segment.carry_over;
+    }
+  }
+  return totals;
 }
 
 IntervalModel& TimeSheet::interval_model() const noexcept
@@ -1,5 +1,10 @@
 #pragma once
 
+#include "aggregation.h"
+#include "timesheetsnapshot.h"
+
+#include <filesystem>
+#include <map>
 #include <memory>
 
 class Plan;
@@ -11,6 +16,19 @@ class ProjectModel;
 class TimeSheet
 {
 public:
+  /**
+   * @brief The intervals of a past year which are stored in a separate file.
+   *  The totals of the year are stored along, so the balance can be computed without loading the intervals.
+   */
+  struct Segment
+  {
+    std::filesystem::path filename;
+    Aggregation::Totals totals;
+
+    // the time the intervals of the year extend into the following year.
+    std::chrono::milliseconds carry_over{0};
+  };
+
   explicit TimeSheet();
   explicit TimeSheet(std::unique_ptr<ProjectModel> project_model, std::unique_ptr<IntervalModel> interval_model,
                      std::unique_ptr<Plan> plan);
@@ -18,8 +36,41 @@ public:
   [[nodiscard]] ProjectModel& project_model() const noexcept;
   [[nodiscard]] Plan& plan() const noexcept;
 
+  /**
+   * @brief returns an immutable copy of the current state which may be passed to other threads.
+   *  Creating a snapshot copies only what changed since the previous snapshot.
+   *  Must be called from the thread which owns the models.
+   */
+  [[nodiscard]] std::shared_ptr<const TimeSheetSnapshot> snapshot() const;
+
+  /**
+   * @brief returns the segments whose intervals have not been loaded yet, keyed by year.
+   */
+  [[nodiscard]] const std::map<int, Segment>& unloaded_segments() const noexcept;
+  void set_unloaded_segments(std::map<int, Segment> segments);
+
+  /**
+   * @brief loads the intervals of all unloaded segments which overlap with the given period.
+   *  Segments are loaded as well when the plan or the intervals of their year change, since their totals get stale.
+   * @throws DeserializationError if any of the segments cannot be loaded. No segment is loaded in that case.
+   */
+  void load_segments(const Period& period);
+
+  /**
+   * @brief returns the totals of the period, where the aggregation accounts for the loaded intervals and the totals
+   *  stored along the unloaded segments account for the years which have not been loaded.
+   *  The time an unloaded year carries over into a loaded year is accounted on the first day of that year.
+   */
+  [[nodiscard]] Aggregation::Totals totals(const Aggregation& aggregation, const Period& period) const;
+
 private:
   std::unique_ptr<ProjectModel> m_project_model;
   std::unique_ptr<IntervalModel> m_interval_model;
   std::unique_ptr<Plan> m_plan;
+  mutable std::shared_ptr<const TimeSheetSnapshot> m_snapshot = std::make_shared<TimeSheetSnapshot>();
+  mutable TimeSheetSnapshot::Changes m_changes;
+  std::map<int, Segment> m_unloaded_segments;
+  void track_changes();
+  void load_segments_on_demand();
+  void mark_changed_rows(int first, int last);
 };
@@ -0,0 +1,111 @@
+#include "timesheetsnapshot.h"
+
+#include "interval.h"
+#include "intervalmodel.h"
+#include "projectmodel.h"
+#include "timesheet.h"
+
+namespace
+{
+
+[[nodiscard]] std::shared_ptr<const TimeSheetSnapshot::Chunk> make_chunk(const IntervalModel& interval_model,
+                                                                         const std::size_t chunk_index)
+{
+  const auto first_row = chunk_index * TimeSheetSnapshot::chunk_size;
+  const auto row_count = static_cast<std::size_t>(interval_model.rowCount());
+  const auto end_row = std::min(first_row + TimeSheetSnapshot::chunk_size, row_count);
+  auto chunk = std::make_shared<TimeSheetSnapshot::Chunk>();
+  chunk->reserve(end_row - first_row);
+  for (auto row = first_row; row < end_row; ++row) {
+    const auto& interval = *interval_model.interval(row);
+    const auto* const project = interval.project();
+    chunk->emplace_back(TimeSheetSnapshot::IntervalRecord{
+        .begin = interval.begin(),
+        .end = interval.end(),
+        .project_id = project == nullptr ? Project::invalid_id : project->id(),
+    });
+  }
+  return chunk;
+}
+
+[[nodiscard]] std::shared_ptr<const std::vector<TimeSheetSnapshot::ProjectRecord>>
+make_projects(const ProjectModel& project_model)
+{
+  auto projects = std::make_shared<std::vector<TimeSheetSnapshot::ProjectRecord>>();
+  projects->reserve(project_model.size());
+  for (const auto* const project : project_model.projects()) {
+    projects->emplace_back(TimeSheetSnapshot::ProjectRecord{.name = project->name(), .color = project->color()});
+  }
+  return projects;
+}
+
+[[nodiscard]] std::shared_ptr<const TimeSheetSnapshot::PlanRecord> make_plan(const Plan& plan)
+{
+  auto record = std::make_shared<TimeSheetSnapshot::PlanRecord>();
+  record->start = plan.start();
+  record->overtime_offset = plan.overtime_offset();
+  record->schedule = plan.schedule();
+  record->holiday_calendar = plan.holiday_calendar();
+  const auto row_count = plan.rowCount({});
+  record->entries.reserve(row_count);
+  for (int row = 0; row < row_count; ++row) {
+    record->entries.emplace_back(plan.entry(row));
+  }
+  return record;
+}
+
+}  // namespace
+
+bool TimeSheetSnapshot::Changes::empty() const noexcept
+{
+  return !all_intervals && interval_chunks.empty() && !plan && !projects;
+}
+
+TimeSheetSnapshot::TimeSheetSnapshot(const TimeSheet& time_sheet, const TimeSheetSnapshot& previous,
+                                     const Changes& changes)
+  : m_interval_chunks(previous.m_interval_chunks)
+  , m_interval_count(time_sheet.interval_model().rowCount())
+  , m_projects(changes.projects ? ::make_projects(time_sheet.project_model()) : previous.m_projects)
+  , m_plan(changes.plan ? ::make_plan(time_sheet.plan()) : previous.m_plan)
+{
+  const auto& interval_model = time_sheet.interval_model();
+  const auto chunk_count = (m_interval_count + chunk_size - 1) / chunk_size;
+  m_interval_chunks.resize(chunk_count);
+  if (changes.all_intervals) {
+    for (std::size_t i = 0; i < chunk_count; ++i) {
+      m_interval_chunks.at(i) = ::make_chunk(interval_model, i);
+    }
+    return;
+  }
+
+  for (const auto i : changes.interval_chunks) {
+    if (i < chunk_count) {
+      m_interval_chunks.at(i) = ::make_chunk(interval_model, i);
+    }
+  }
+}
+
+std::size_t TimeSheetSnapshot::interval_count() const noexcept
+{
+  return m_interval_count;
+}
+
+const TimeSheetSnapshot::IntervalRecord& TimeSheetSnapshot::interval(const std::size_t row) const
+{
+  return m_interval_chunks.at(row / chunk_size)->at(row % chunk_size);
+}
+
+const std::vector<std::shared_ptr<const TimeSheetSnapshot::Chunk>>& TimeSheetSnapshot::interval_chunks() const noexcept
+{
+  return m_interval_chunks;
+}
+
+const std::vector<TimeSheetSnapshot::ProjectRecord>& TimeSheetSnapshot::projects() const noexcept
+{
+  return *m_projects;
+}
+
+const TimeSheetSnapshot::PlanRecord& TimeSheetSnapshot::plan() const noexcept
+{
+  return *m_plan;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "holidaycalendar.h"
+#include "plan.h"
+#include "project.h"
+#include "schedule.h"
+
+#include <QColor>
+#include <QDateTime>
+#include <array>
+#include <chrono>
+#include <memory>
+#include <set>
+#include <vector>
+
+class TimeSheet;
+
+/**
+ * @class TimeSheetSnapshot timesheetsnapshot.h "timesheetsnapshot.h"
+ * @brief An immutable copy of a TimeSheet which can be read from any thread while the TimeSheet is being edited.
+ * Snapshots share the data which did not change in between:
+ * the intervals are stored in chunks of consecutive rows, and each chunk, the plan and the projects are shared
+ * until they are modified.
+ * @see TimeSheet::snapshot
+ */
+class TimeSheetSnapshot
+{
+public:
+  struct IntervalRecord
+  {
+    QDateTime begin;
+    QDateTime end;
+    Project::Id project_id = Project::invalid_id;
+  };
+
+  struct ProjectRecord
+  {
+    QString name;
+    QColor color;
+  };
+
+  struct PlanRecord
+  {
+    QDate start;
+    std::chrono::minutes overtime_offset{0};
+    Schedule schedule;
+    HolidayCalendar holiday_calendar;
+    std::vector<Plan::Entry> entries;
+  };
+
+  /**
+   * @brief Identifies the parts of a TimeSheet which changed since the previous snapshot.
+   */
+  struct Changes
+  {
+    bool all_intervals = true;
+    std::set<std::size_t> interval_chunks;
+    bool plan = true;
+    bool projects = true;
+    [[nodiscard]] bool empty() const noexcept;
+  };
+
+  static constexpr std::size_t chunk_size = 512;
+  using Chunk = std::vector<IntervalRecord>;
+
+  explicit TimeSheetSnapshot() = default;
+
+  /**
+   * @brief creates a snapshot of the time sheet which shares everything but the changed parts with the previous one.
+   */
+  explicit TimeSheetSnapshot(const TimeSheet& time_sheet, const TimeSheetSnapshot& previous, const Changes& changes);
+
+  [[nodiscard]] std::size_t interval_count() const noexcept;
+  [[nodiscard]] const IntervalRecord& interval(std::size_t row) const;
+  [[nodiscard]] const std::vector<std::shared_ptr<const Chunk>>& interval_chunks() const noexcept;
+
+  /**
+   * @brief returns the projects, indexed by Project::Id.
+   */
+  [[nodiscard]] const std::vector<ProjectRecord>& projects() const noexcept;
+  [[nodiscard]] const PlanRecord& plan() const noexcept;
+
+private:
+  std::vector<std::shared_ptr<const Chunk>> m_interval_chunks;
+  std::size_t m_interval_count = 0;
+  std::shared_ptr<const std::vector<ProjectRecord>> m_projects = std::make_shared<std::vector<ProjectRecord>>();
+  std::shared_ptr<const PlanRecord> m_plan = std::make_shared<PlanRecord>();
+};
@@ -0,0 +1,33 @@
+#include "transaction.h"
+
+#include <algorithm>
+#include <utility>
+
+int Transaction::m_depth = 0;
+std::vector<std::pair<const void*, std::function<void()>>> Transaction::m_pending;
+
+Transaction::Transaction() noexcept
+{
+  m_depth += 1;
+}
+
+Transaction::~Transaction()
+{
+  m_depth -= 1;
+  if (m_depth > 0) {
+    return;
+  }
+  // notifications may open new transactions, hence take the pending callbacks before invoking them.
+  for (const auto& [key, notify] : std::exchange(m_pending, {})) {
+    notify();
+  }
+}
+
+void Transaction::defer(const void* const key, std::function<void()> notify)
+{
+  if (m_depth == 0) {
+    notify();
+  } else if (std::ranges::find(m_pending, key, &decltype(m_pending)::value_type::first) == m_pending.end()) {
+    m_pending.emplace_back(key, std::move(notify));
+  }
+}
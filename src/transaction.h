@@ -0,0 +1,34 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+/**
+ * @class Transaction transaction.h "transaction.h"
+ * @brief While a Transaction is alive, models defer their change notifications.
+ * The deferred notifications are emitted once, when the outermost Transaction ends.
+ * Models accumulate what changed themselves and register a single callback which emits the summary.
+ * Transactions are opened by UndoStack::Macro and around undo and redo, hence all changes made by one macro
+ * notify the views only once.
+ */
+class Transaction
+{
+public:
+  explicit Transaction() noexcept;
+  ~Transaction();
+  Transaction(const Transaction&) = delete;
+  Transaction(Transaction&&) = delete;
+  Transaction& operator=(const Transaction&) = delete;
+  Transaction& operator=(Transaction&&) = delete;
+
+  /**
+   * @brief invokes @code notify when the outermost Transaction ends or immediately if there is no Transaction.
+   *  A callback registered for a @code key which is already pending is dropped, i.e., the pending callback must
+   *  emit the accumulated changes.
+   */
+  static void defer(const void* key, std::function<void()> notify);
+
+private:
+  static int m_depth;
+  static std::vector<std::pair<const void*, std::function<void()>>> m_pending;
+};
@@ -23,7 +23,12 @@ void AbstractPeriodView::set_model(const TimeSheet* const time_sheet)
   m_time_sheet = time_sheet;
   invalidate();
   if (m_time_sheet != nullptr) {
-    connect(&m_time_sheet->interval_model(), &IntervalModel::data_changed, this, &AbstractPeriodView::invalidate);
+    connect(&m_time_sheet->interval_model(), &IntervalModel::data_changed, this,
+            [this](const Period& affected_period) {
+              if (relevant_period().contains(affected_period)) {
+                invalidate();
+              }
+            });
   }
 }
 
@@ -36,3 +41,8 @@ const TimeSheet* AbstractPeriodView::time_sheet() const
 {
   return m_time_sheet;
 }
+
+Period AbstractPeriodView::relevant_period() const
+{
+  return m_current_period;
+}
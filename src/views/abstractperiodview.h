@@ -21,6 +21,13 @@ public:
   virtual void invalidate() = 0;
   [[nodiscard]] const TimeSheet* time_sheet() const;
 
+protected:
+  /**
+   * @brief returns the days which this view depends on.
+   *  The view is only invalidated if a change affects these days.
+   */
+  [[nodiscard]] virtual Period relevant_period() const;
+
 private:
   Period m_current_period;
   const TimeSheet* m_time_sheet = nullptr;
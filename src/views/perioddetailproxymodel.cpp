@@ -1,21 +1,77 @@
 #include "views/perioddetailproxymodel.h"
 #include "intervalmodel.h"
 
-PeriodDetailProxyModel::PeriodDetailProxyModel(QObject* parent) : QSortFilterProxyModel(parent)
+namespace
+{
+
+[[nodiscard]] bool less_by_column(const Interval& a, const Interval& b, const int column)
+{
+  switch (column) {
+  case IntervalModel::project_column: {
+    static constexpr auto name = [](const Interval& interval) {
+      return interval.project() == nullptr ? QString{} : interval.project()->name();
+    };
+    if (const auto c = QString::compare(name(a), name(b)); c != 0) {
+      return c < 0;
+    }
+    break;
+  }
+  case IntervalModel::end_column:
+    if (a.end() != b.end()) {
+      return a.end() < b.end();
+    }
+    break;
+  case IntervalModel::duration_column:
+    if (const auto da = a.duration(), db = b.duration(); da != db) {
+      return da < db;
+    }
+    break;
+  default:
+    break;
+  }
+  if (const auto c = a <=> b; c != 0) {
+    return c < 0;
+  }
+  return std::less<>{}(&a, &b);
+}
+
+}  // namespace
+
+PeriodDetailProxyModel::PeriodDetailProxyModel(QObject* parent)
+  : QAbstractProxyModel(parent), m_sort_column(IntervalModel::begin_column)
 {
-  setSortRole(Qt::EditRole);
 }
 
 void PeriodDetailProxyModel::set_source_model(IntervalModel* const model)
 {
+  for (const auto& connection : m_connections) {
+    disconnect(connection);
+  }
+  m_connections.clear();
+
   m_interval_model = model;
   setSourceModel(model);
+  if (m_interval_model != nullptr) {
+    using M = IntervalModel;
+    using P = PeriodDetailProxyModel;
+    m_connections = {
+        connect(model, &M::rowsInserted, this, &P::on_rows_inserted),
+        connect(model, &M::rowsAboutToBeRemoved, this, &P::on_rows_about_to_be_removed),
+        connect(model, &M::dataChanged, this, &P::on_data_changed),
+        connect(model, &M::modelReset, this, &P::rebuild),
+        connect(model, &QObject::destroyed, this, [this]() {
+          m_interval_model = nullptr;
+          rebuild();
+        }),
+    };
+  }
+  rebuild();
 }
 
 void PeriodDetailProxyModel::set_period(const Period& period)
 {
   m_period = period;
-  invalidate();
+  rebuild();
 }
 
 const IntervalModel* PeriodDetailProxyModel::interval_model() const noexcept
@@ -28,13 +84,205 @@ const Period& PeriodDetailProxyModel::current_period() const noexcept
   return m_period;
 }
 
-bool PeriodDetailProxyModel::filterAcceptsRow(const int source_row, const QModelIndex& source_parent) const
+bool PeriodDetailProxyModel::accepts(const Interval& interval) const
 {
-  if (interval_model() == nullptr) {
-    return false;
-  }
-  const auto* const interval = interval_model()->interval(source_row);
-  const Period period(interval->begin().date(),
-                      (interval->end().isValid() ? interval->end() : interval->begin()).date());
+  const Period period(interval.begin().date(), (interval.end().isValid() ? interval.end() : interval.begin()).date());
   return current_period().contains(period);
 }
+
+QModelIndex PeriodDetailProxyModel::mapToSource(const QModelIndex& proxy_index) const
+{
+  if (!proxy_index.isValid() || m_interval_model == nullptr) {
+    return {};
+  }
+  const auto source_row = m_interval_model->index(*m_intervals.at(proxy_index.row())).row();
+  return m_interval_model->index(source_row, proxy_index.column());
+}
+
+QModelIndex PeriodDetailProxyModel::mapFromSource(const QModelIndex& source_index) const
+{
+  if (!source_index.isValid() || m_interval_model == nullptr) {
+    return {};
+  }
+  const auto it = m_rows.find(m_interval_model->interval(source_index.row()));
+  if (it == m_rows.end()) {
+    return {};
+  }
+  return index(it->second, source_index.column());
+}
+
+QModelIndex PeriodDetailProxyModel::index(const int row, const int column, const QModelIndex& parent) const
+{
+  if (parent.isValid() || row < 0 || row >= rowCount() || column < 0 || column >= columnCount()) {
+    return {};
+  }
+  return createIndex(row, column);
+}
+
+QModelIndex PeriodDetailProxyModel::parent(const QModelIndex&) const
+{
+  return {};
+}
+
+int PeriodDetailProxyModel::rowCount(const QModelIndex& parent) const
+{
+  return parent.isValid() ? 0 : static_cast<int>(m_intervals.size());
+}
+
+int PeriodDetailProxyModel::columnCount(const QModelIndex& parent) const
+{
+  return parent.isValid() || m_interval_model == nullptr ? 0 : m_interval_model->columnCount();
+}
+
+QVariant PeriodDetailProxyModel::headerData(const int section, const Qt::Orientation orientation,
+                                            const int role) const
+{
+  if (m_interval_model == nullptr) {
+    return {};
+  }
+  return m_interval_model->headerData(section, orientation, role);
+}
+
+void PeriodDetailProxyModel::sort(const int column, const Qt::SortOrder order)
+{
+  m_sort_column = column;
+  m_sort_order = order;
+
+  Q_EMIT layoutAboutToBeChanged({}, VerticalSortHint);
+  const auto persistent_indexes = persistentIndexList();
+  std::vector<std::pair<const Interval*, int>> persistent_intervals;
+  persistent_intervals.reserve(persistent_indexes.size());
+  for (const auto& index : persistent_indexes) {
+    persistent_intervals.emplace_back(m_intervals.at(index.row()), index.column());
+  }
+
+  std::ranges::stable_sort(m_intervals, [this](const auto* a, const auto* b) { return less(*a, *b); });
+  update_rows(0);
+
+  QModelIndexList updated_persistent_indexes;
+  updated_persistent_indexes.reserve(persistent_indexes.size());
+  for (const auto& [interval, column] : persistent_intervals) {
+    updated_persistent_indexes.append(index(m_rows.at(interval), column));
+  }
+  changePersistentIndexList(persistent_indexes, updated_persistent_indexes);
+  Q_EMIT layoutChanged({}, VerticalSortHint);
+}
+
+bool PeriodDetailProxyModel::less(const Interval& a, const Interval& b) const
+{
+  return m_sort_order == Qt::AscendingOrder ? ::less_by_column(a, b, m_sort_column)
+                                            : ::less_by_column(b, a, m_sort_column);
+}
+
+int PeriodDetailProxyModel::insert_position(const Interval& interval) const
+{
+  const auto it = std::ranges::upper_bound(m_intervals, &interval,
+                                           [this](const auto* a, const auto* b) { return less(*a, *b); });
+  return static_cast<int>(std::distance(m_intervals.begin(), it));
+}
+
+void PeriodDetailProxyModel::update_rows(const int first)
+{
+  for (auto row = first; row < static_cast<int>(m_intervals.size()); ++row) {
+    m_rows.insert_or_assign(m_intervals.at(row), row);
+  }
+}
+
+void PeriodDetailProxyModel::rebuild()
+{
+  beginResetModel();
+  m_intervals.clear();
+  m_rows.clear();
+  if (m_interval_model != nullptr) {
+    for (const auto* const interval : m_interval_model->intervals(m_period)) {
+      if (accepts(*interval)) {
+        m_intervals.emplace_back(interval);
+      }
+    }
+    std::ranges::stable_sort(m_intervals, [this](const auto* a, const auto* b) { return less(*a, *b); });
+    update_rows(0);
+  }
+  endResetModel();
+}
+
+void PeriodDetailProxyModel::insert(const Interval& interval)
+{
+  if (m_rows.contains(&interval)) {
+    return;
+  }
+  const auto row = insert_position(interval);
+  beginInsertRows({}, row, row);
+  m_intervals.insert(m_intervals.begin() + row, &interval);
+  update_rows(row);
+  endInsertRows();
+}
+
+void PeriodDetailProxyModel::remove(const Interval& interval)
+{
+  const auto it = m_rows.find(&interval);
+  if (it == m_rows.end()) {
+    return;
+  }
+  const auto row = it->second;
+  beginRemoveRows({}, row, row);
+  m_rows.erase(it);
+  m_intervals.erase(m_intervals.begin() + row);
+  update_rows(row);
+  endRemoveRows();
+}
+
+void PeriodDetailProxyModel::reposition(const Interval& interval)
+{
+  const auto row = m_rows.at(&interval);
+  m_intervals.erase(m_intervals.begin() + row);
+  const auto new_row = insert_position(interval);
+  m_intervals.insert(m_intervals.begin() + row, &interval);
+  if (new_row == row) {
+    return;
+  }
+
+  beginMoveRows({}, row, row, {}, new_row > row ? new_row + 1 : new_row);
+  m_intervals.erase(m_intervals.begin() + row);
+  m_intervals.insert(m_intervals.begin() + new_row, &interval);
+  update_rows(std::min(row, new_row));
+  endMoveRows();
+}
+
+void PeriodDetailProxyModel::on_rows_inserted(const QModelIndex& parent, const int first, const int last)
+{
+  if (parent.isValid()) {
+    return;
+  }
+  for (auto row = first; row <= last; ++row) {
+    if (const auto& interval = *m_interval_model->interval(row); accepts(interval)) {
+      insert(interval);
+    }
+  }
+}
+
+void PeriodDetailProxyModel::on_rows_about_to_be_removed(const QModelIndex& parent, const int first, const int last)
+{
+  if (parent.isValid()) {
+    return;
+  }
+  for (auto row = first; row <= last; ++row) {
+    remove(*m_interval_model->interval(row));
+  }
+}
+
+void PeriodDetailProxyModel::on_data_changed(const QModelIndex& top_left, const QModelIndex& bottom_right)
+{
+  for (auto source_row = top_left.row(); source_row <= bottom_right.row(); ++source_row) {
+    const auto& interval = *m_interval_model->interval(source_row);
+    const auto is_present = m_rows.contains(&interval);
+    if (const auto is_accepted = accepts(interval); is_present && !is_accepted) {
+      remove(interval);
+    } else if (!is_present && is_accepted) {
+      insert(interval);
+    } else if (is_present) {
+      reposition(interval);
+      const auto row = m_rows.at(&interval);
+      Q_EMIT dataChanged(index(row, 0), index(row, columnCount() - 1));
+    }
+  }
+}
@@ -1,23 +1,58 @@
 #pragma once
 
 #include "period.h"
-#include <QSortFilterProxyModel>
+#include <QAbstractProxyModel>
+#include <unordered_map>
+#include <vector>
 
+class Interval;
 class IntervalModel;
 
-class PeriodDetailProxyModel : public QSortFilterProxyModel
+/**
+ * @class PeriodDetailProxyModel perioddetailproxymodel.h "views/perioddetailproxymodel.h"
+ * @brief Presents the intervals of the current period in sorted order.
+ * The matching intervals are obtained from the range query of the IntervalModel, i.e., switching the period does
+ * not visit all intervals.
+ * Changes of the source model are applied incrementally.
+ */
+class PeriodDetailProxyModel : public QAbstractProxyModel
 {
 public:
-  explicit PeriodDetailProxyModel(QObject *parent = nullptr);
+  explicit PeriodDetailProxyModel(QObject* parent = nullptr);
   void set_source_model(IntervalModel* const model);
   void set_period(const Period& period);
 
+  [[nodiscard]] QModelIndex mapToSource(const QModelIndex& proxy_index) const override;
+  [[nodiscard]] QModelIndex mapFromSource(const QModelIndex& source_index) const override;
+  [[nodiscard]] QModelIndex index(int row, int column, const QModelIndex& parent = {}) const override;
+  [[nodiscard]] QModelIndex parent(const QModelIndex& child) const override;
+  [[nodiscard]] int rowCount(const QModelIndex& parent = {}) const override;
+  [[nodiscard]] int columnCount(const QModelIndex& parent = {}) const override;
+  [[nodiscard]] QVariant headerData(int section, Qt::Orientation orientation, int role) const override;
+  void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
 protected:
   [[nodiscard]] const IntervalModel* interval_model() const noexcept;
   [[nodiscard]] const Period& current_period() const noexcept;
-  [[nodiscard]] bool filterAcceptsRow(int source_row, const QModelIndex& source_parent) const override;
+  [[nodiscard]] bool accepts(const Interval& interval) const;
 
 private:
-  const IntervalModel* m_interval_model = nullptr;
+  IntervalModel* m_interval_model = nullptr;
   Period m_period;
+  int m_sort_column = 0;
+  Qt::SortOrder m_sort_order = Qt::AscendingOrder;
+  std::vector<const Interval*> m_intervals;
+  std::unordered_map<const Interval*, int> m_rows;
+  std::vector<QMetaObject::Connection> m_connections;
+
+  [[nodiscard]] bool less(const Interval& a, const Interval& b) const;
+  [[nodiscard]] int insert_position(const Interval& interval) const;
+  void update_rows(int first);
+  void rebuild();
+  void insert(const Interval& interval);
+  void remove(const Interval& interval);
+  void reposition(const Interval& interval);
+  void on_rows_inserted(const QModelIndex& parent, int first, int last);
+  void on_rows_about_to_be_removed(const QModelIndex& parent, int first, int last);
+  void on_data_changed(const QModelIndex& top_left, const QModelIndex& bottom_right);
 };
@@ -106,13 +106,16 @@ public:
   void setModelData(QWidget* const editor, QAbstractItemModel* const model, const QModelIndex& index) const override
   {
     const auto& combo_box = dynamic_cast<QComboBox&>(*editor);
+    const auto& project_model = m_time_sheet->project_model();
+    const auto current_text = combo_box.currentText();
     const Project* project = nullptr;
-    if (combo_box.currentIndex() >= m_time_sheet->project_model().projects().size()) {
-      project = nullptr;
-    } else if (const auto current_text = combo_box.currentText();
-               current_text == combo_box.itemText(combo_box.currentIndex()))
+    if (const auto no_project_index = static_cast<int>(project_model.size());
+        current_text.isEmpty()
+        || (combo_box.currentIndex() == no_project_index && current_text == combo_box.itemText(no_project_index)))
     {
-      project = &m_time_sheet->project_model().project(combo_box.currentIndex());
+      project = nullptr;
+    } else if (const auto* const existing_project = project_model.find(current_text); existing_project != nullptr) {
+      project = existing_project;
     } else if (QMessageBox::question(editor, QApplication::applicationDisplayName(),
                                      tr("There is no project '%1'. Do you want to create it?").arg(current_text),
                                      QMessageBox::Yes | QMessageBox::No)
@@ -272,5 +275,4 @@ void PeriodDetailView::edit_date_time(const QModelIndex& index) const
       make_modify_interval_command(time_sheet()->interval_model(), interval, e.begin(), &Interval::swap_begin));
   Application::undo_stack().push(
       make_modify_interval_command(time_sheet()->interval_model(), interval, e.end(), &Interval::swap_end));
-  Q_EMIT time_sheet()->interval_model().data_changed();
 }
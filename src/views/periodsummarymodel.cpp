@@ -1,5 +1,6 @@
 #include "views/periodsummarymodel.h"
 #include "colorutil.h"
+#include "durationtext.h"
 #include "intervalmodel.h"
 #include "projectmodel.h"
 #include "timesheet.h"
@@ -27,22 +28,13 @@ private:
 namespace
 {
 
-[[nodiscard]] auto format_minutes(const std::chrono::minutes& minutes)
+[[nodiscard]] QString format_minutes(const std::chrono::minutes& minutes)
 {
   using std::chrono_literals::operator""min;
-  using std::chrono_literals::operator""h;
-
-  static constexpr auto field_width = 2;
-  static constexpr auto base = 10;
-  static constexpr auto fill_char = QChar('0');
-
   if (minutes == 0min) {
     return QString{};
   }
-
-  return QString("%1:%2")
-      .arg(minutes / 1h, field_width, base, fill_char)
-      .arg((minutes / 1min) % (1h / 1min), field_width, base, fill_char);
+  return ::duration_text(minutes);
 };
 
 class ProjectRow final : public PeriodSummaryModel::Row
@@ -60,7 +52,7 @@ public:
     case Qt::BackgroundRole:
       return m_project.color();
     case Qt::ForegroundRole:
-      return ::contrast_color(m_project.color());
+      return m_project.contrast_color();
     default:
       return {};
     }
@@ -80,7 +72,7 @@ public:
       }
       return ::background(date);
     case Qt::ForegroundRole:
-      return duration == 0min ? QVariant{} : ::contrast_color(m_project.color());
+      return duration == 0min ? QVariant{} : m_project.contrast_color();
     default:
       return {};
     }
@@ -194,6 +186,15 @@ void PeriodSummaryModel::set_source(const TimeSheet* model)
   m_time_sheet = model;
   if (m_time_sheet != nullptr) {
     connect(&m_time_sheet->project_model(), &ProjectModel::projects_changed, this, &PeriodSummaryModel::invalidate);
+    connect(&m_time_sheet->interval_model(), &IntervalModel::data_changed, this, [this](const Period& affected_period) {
+      if (!m_period.contains(affected_period)) {
+        return;
+      }
+      update_summary();
+      if (rowCount({}) > 0 && columnCount({}) > 0) {
+        Q_EMIT dataChanged(index(0, 0), index(rowCount({}) - 1, columnCount({}) - 1));
+      }
+    });
   }
   invalidate();
   update_summary();
@@ -237,34 +238,17 @@ void PeriodSummaryModel::invalidate()
 
 void PeriodSummaryModel::update_summary()
 {
-  m_minutes.clear();
   if (m_time_sheet == nullptr) {
-    return;
-  }
-
-  for (const auto* interval : m_time_sheet->interval_model().intervals(m_period)) {
-    using std::chrono_literals::operator""min;
-    auto& duration = m_minutes.try_emplace(interval->begin().date())
-                         .first->second.try_emplace(interval->project(), 0min)
-                         .first->second;
-    duration += interval->duration();
+    m_minutes = DailyMinutes{};
+  } else {
+    m_minutes = m_time_sheet->interval_model().daily_minutes(m_period);
   }
 }
 
 std::chrono::minutes PeriodSummaryModel::get_duration(const QDate& date, const Project* project) const
 {
-  const auto it_1 = m_minutes.find(date);
-  using std::chrono_literals::operator""min;
-  if (it_1 == m_minutes.end()) {
-    return 0min;
-  }
   if (project == nullptr) {
-    return std::accumulate(it_1->second.begin(), it_1->second.end(), 0min,
-                           [](const auto& accu, const auto& pair) { return accu + pair.second; });
-  }
-  const auto it_2 = it_1->second.find(project);
-  if (it_2 == it_1->second.end()) {
-    return 0min;
+    return m_minutes.minutes(date);
   }
-  return it_2->second;
+  return m_minutes.minutes(date, project->id());
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "dailyminutes.h"
 #include "period.h"
 #include "timesheet.h"
 
@@ -29,7 +30,7 @@ public:
 private:
   const TimeSheet* m_time_sheet = nullptr;
   void update_summary();
-  std::map<QDate, std::map<const Project*, std::chrono::minutes>> m_minutes;
+  DailyMinutes m_minutes;
   Period m_period;
 
   std::vector<std::unique_ptr<Row>> m_rows;
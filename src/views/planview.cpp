@@ -1,5 +1,6 @@
 #include "views/planview.h"
 #include "application.h"
+#include "durationtext.h"
 #include "fmt.h"
 #include "intervalmodel.h"
 #include "plan.h"
@@ -8,29 +9,12 @@
 #include "ui_planview.h"
 
 #include <QPainter>
+#include <QThreadPool>
 #include <QPainterPath>
 #include <spdlog/spdlog.h>
 
 int PlanView::m_max_period_text_width = 0;
 
-namespace
-{
-
-[[nodiscard]] auto format_minutes(const std::chrono::minutes minutes)
-{
-  using std::chrono_literals::operator""h;
-  using std::chrono_literals::operator""min;
-  static constexpr auto field_width = 2;
-  static constexpr auto base = 10;
-  static constexpr auto fill_char = QChar('0');
-  return QString{"%1%2:%3"}
-      .arg(minutes < 0min ? "-" : "")
-      .arg(std::abs(minutes / 1h), field_width, base, fill_char)
-      .arg(std::abs((minutes / 1min)) % (1h / 1min), field_width, base, fill_char);
-}
-
-}  // namespace
-
 PlanView::PlanView(QWidget* parent) : AbstractPeriodView(parent), m_ui(std::make_unique<Ui::PlanView>())
 {
   m_ui->setupUi(this);
@@ -50,12 +34,6 @@ void PlanView::clear() const
   }
 }
 
-std::chrono::minutes expected_working_time(const Plan& plan, const IntervalModel& interval_model, const Period& period)
-{
-  const auto actual_end = std::clamp(period.end(), plan.start(), Application::current_date_time().date());
-  return plan.planned_working_time(Period{period.begin(), actual_end}, interval_model);
-}
-
 void PlanView::invalidate()
 {
   if (time_sheet() == nullptr) {
@@ -67,32 +45,28 @@ void PlanView::invalidate()
   const Period current_period(std::max(this->current_period().begin(), plan.start()),
                               std::min(this->current_period().end(), Application::current_date_time().date()));
 
-  using std::chrono_literals::operator""min;
-  const auto& interval_model = time_sheet()->interval_model();
-  const auto actual_working_time = interval_model.minutes(current_period);
-  const auto sick_time = time_sheet()->plan().sick_time(current_period);
-  const auto vacation_time = time_sheet()->plan().vacation_time(current_period);
-  const auto holiday_time = time_sheet()->plan().holiday_time(current_period);
-  const auto expected_working_time = ::expected_working_time(plan, interval_model, current_period);
+  const auto totals = this->totals(current_period);
+  const auto actual_working_time = totals.actual_minutes();
+  const auto expected_working_time = totals.planned;
   const auto balance = actual_working_time - expected_working_time;
   const Period total_period{plan.start(), current_period.end()};
-  const auto total_balance = plan.overtime_offset() + interval_model.minutes(total_period)
-                             - ::expected_working_time(plan, interval_model, total_period);
+  const auto total_totals = this->totals(total_period);
+  const auto total_balance = plan.overtime_offset() + total_totals.actual_minutes() - total_totals.planned;
   const auto balance_carryover = total_balance - balance;
 
   m_ui->lb_period->setText(period_text(current_period));
   m_ui->lb_period->setToolTip(
       tr("From %1 to %2").arg(current_period.begin().toString()).arg(current_period.end().toString()));
-  m_ui->lb_expected_worktime->setText(::format_minutes(expected_working_time));
-  m_ui->lb_sick->setText(::format_minutes(sick_time));
-  m_ui->lb_holiday->setText(::format_minutes(holiday_time));
-  m_ui->lb_vacation->setText(::format_minutes(vacation_time));
-  m_ui->lb_actual_worktime->setText(::format_minutes(actual_working_time));
-  m_ui->lb_balance_carryover->setText(::format_minutes(balance_carryover));
+  m_ui->lb_expected_worktime->setText(::duration_text(expected_working_time));
+  m_ui->lb_sick->setText(::duration_text(totals.sick));
+  m_ui->lb_holiday->setText(::duration_text(totals.holiday));
+  m_ui->lb_vacation->setText(::duration_text(totals.vacation));
+  m_ui->lb_actual_worktime->setText(::duration_text(actual_working_time));
+  m_ui->lb_balance_carryover->setText(::duration_text(balance_carryover));
   m_ui->lb_balance_carryover->setToolTip(
       tr("The balance from before this period (since %1)").arg(plan.start().toString()));
-  m_ui->lb_period_balance->setText(::format_minutes(balance));
-  m_ui->lb_total_balance->setText(::format_minutes(total_balance));
+  m_ui->lb_period_balance->setText(::duration_text(balance));
+  m_ui->lb_total_balance->setText(::duration_text(total_balance));
   m_ui->lb_total_balance->setToolTip(
       tr("The balance since the beginning of records (including this period, from %1 to %2).")
           .arg(plan.start().toString(), current_period.end().toString()));
@@ -112,6 +86,34 @@ QSize PlanView::sizeHint() const
   return size_hint;
 }
 
+const Aggregation& PlanView::aggregation() const
+{
+  // The history since the start of the plan is aggregated once and reused while browsing periods.
+  const auto snapshot = time_sheet()->snapshot();
+  const Period period{time_sheet()->plan().start(), Application::current_date_time().date()};
+  if (m_aggregation.snapshot() != snapshot || m_aggregation.period() != period) {
+    m_aggregation = Aggregation{snapshot, period, *QThreadPool::globalInstance()};
+  } else if (m_aggregation.depends_on_current_time()) {
+    // while a timer is running, only the days of the open intervals are aggregated again.
+    m_aggregation.update_open_intervals();
+  }
+  return m_aggregation;
+}
+
+Aggregation::Totals PlanView::totals(const Period& period) const
+{
+  return time_sheet()->totals(aggregation(), period);
+}
+
+Period PlanView::relevant_period() const
+{
+  if (time_sheet() == nullptr) {
+    return current_period();
+  }
+  // the total balance accounts for everything since the start of the plan.
+  return Period{std::min(time_sheet()->plan().start(), current_period().begin()), current_period().end()};
+}
+
 QString PlanView::period_text(const Period& period) const
 {
   return current_period().label() + (current_period().limits() == period.limits() ? "" : "*");
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "abstractperiodview.h"
+#include "aggregation.h"
 #include <memory>
 
 namespace Ui
@@ -17,8 +18,14 @@ public:
   void invalidate() override;
   [[nodiscard]] QSize sizeHint() const override;
 
+protected:
+  [[nodiscard]] Period relevant_period() const override;
+
 private:
   std::unique_ptr<Ui::PlanView> m_ui;
   static int m_max_period_text_width;
+  mutable Aggregation m_aggregation;
   [[nodiscard]] QString period_text(const Period& period) const;
+  [[nodiscard]] const Aggregation& aggregation() const;
+  [[nodiscard]] Aggregation::Totals totals(const Period& period) const;
 };
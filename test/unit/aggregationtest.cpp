@@ -0,0 +1,82 @@
+#include "aggregation.h"
+#include "application.h"
+#include "intervalmodel.h"
+#include "plan.h"
+#include "projectmodel.h"
+#include "testutil.h"
+#include "timesheet.h"
+
+#include <QThreadPool>
+#include <gtest/gtest.h>
+
+namespace
+{
+
+using std::chrono_literals::operator""h;
+using std::chrono_literals::operator""min;
+
+}  // namespace
+
+TEST(AggregationTest, MatchesPlanAndIntervalModel)
+{
+  TimeSheet time_sheet;
+  const auto& project = time_sheet.project_model().add(std::make_unique<Project>("a", Qt::red));
+  auto& interval_model = time_sheet.interval_model();
+  // crosses the end of January
+  interval_model.add(make_interval(&project, QDateTime{QDate{2025, 1, 31}, QTime{20, 0}},
+                                   QDateTime{QDate{2025, 2, 1}, QTime{2, 0}}));
+  interval_model.add(make_interval(&project, QDateTime{QDate{2025, 2, 3}, QTime{8, 0}},
+                                   QDateTime{QDate{2025, 2, 3}, QTime{12, 30}}));
+  auto& plan = time_sheet.plan();
+  plan.add(std::make_unique<Plan::Entry>(Period{QDate{2025, 2, 3}, QDate{2025, 2, 3}}, Plan::Kind::Sick));
+  plan.add(std::make_unique<Plan::Entry>(Period{QDate{2025, 2, 4}, QDate{2025, 2, 5}}, Plan::Kind::Vacation));
+
+  const Period year{QDate{2025, 1, 1}, QDate{2025, 12, 31}};
+  const Aggregation aggregation{time_sheet.snapshot(), year, *QThreadPool::globalInstance()};
+
+  const auto periods = {
+      Period{QDate{2025, 1, 31}, QDate{2025, 1, 31}},
+      Period{QDate{2025, 2, 1}, Period::Type::Month},
+      Period{QDate{2025, 1, 20}, QDate{2025, 2, 10}},
+      year,
+  };
+  for (const auto& period : periods) {
+    const auto totals = aggregation.totals(period);
+    EXPECT_EQ(interval_model.minutes(period), totals.actual_minutes());
+    EXPECT_EQ(plan.planned_working_time(period, interval_model), totals.planned);
+    EXPECT_EQ(plan.sick_time(period), totals.sick);
+    EXPECT_EQ(plan.vacation_time(period), totals.vacation);
+    EXPECT_EQ(plan.holiday_time(period), totals.holiday);
+  }
+
+  const auto february = aggregation.totals(Period{QDate{2025, 2, 1}, Period::Type::Month});
+  EXPECT_EQ(6h + 30min, february.actual_minutes());
+  EXPECT_EQ(8h, february.sick);
+  EXPECT_EQ(16h, february.vacation);
+  EXPECT_EQ(0min, aggregation.totals(Period{QDate{2026, 1, 1}, QDate{2026, 1, 31}}).planned);
+}
+
+TEST(AggregationTest, AccountsOpenIntervalsOnTopOfClosedOnes)
+{
+  TimeSheet time_sheet;
+  const auto& project = time_sheet.project_model().add(std::make_unique<Project>("a", Qt::red));
+  auto& interval_model = time_sheet.interval_model();
+  const auto yesterday = Application::current_date_time().date().addDays(-1);
+  interval_model.add(make_interval(&project, QDateTime{yesterday, QTime{8, 0}}, QDateTime{yesterday, QTime{9, 0}}));
+  interval_model.add(make_interval(&project, QDateTime{yesterday, QTime{20, 0}}, QDateTime{}));
+  auto& plan = time_sheet.plan();
+  plan.add(std::make_unique<Plan::Entry>(Period{yesterday, yesterday}, Plan::Kind::Sick));
+
+  const Period days{yesterday.addDays(-1), yesterday.addDays(1)};
+  Aggregation aggregation{time_sheet.snapshot(), days, *QThreadPool::globalInstance()};
+  ASSERT_TRUE(aggregation.depends_on_current_time());
+
+  const Period period{yesterday, yesterday};
+  for (auto i = 0; i < 2; ++i) {
+    const auto totals = aggregation.totals(period);
+    EXPECT_EQ(5h, totals.actual_minutes());
+    EXPECT_EQ(plan.planned_working_time(period, interval_model), totals.planned);
+    EXPECT_EQ(0min, aggregation.totals(Period{days.begin(), days.begin()}).actual_minutes());
+    aggregation.update_open_intervals();
+  }
+}
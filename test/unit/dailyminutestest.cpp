@@ -0,0 +1,54 @@
+#include "dailyminutes.h"
+#include "interval.h"
+#include "project.h"
+#include "projectmodel.h"
+#include "testutil.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+using std::chrono_literals::operator""h;
+using std::chrono_literals::operator""min;
+
+}  // namespace
+
+TEST(DailyMinutesTest, SplitAtMidnight)
+{
+  ProjectModel project_model;
+  const auto& project = project_model.add(std::make_unique<Project>("night shift", Qt::red));
+  const auto interval = make_interval(&project, january(6, 22), january(7, 2, 30));
+  const DailyMinutes minutes{Period{QDate{2025, 1, 6}, QDate{2025, 1, 8}}, {interval.get()}};
+  EXPECT_EQ(2h, minutes.minutes(QDate{2025, 1, 6}, project.id()));
+  EXPECT_EQ(2h + 30min, minutes.minutes(QDate{2025, 1, 7}, project.id()));
+  EXPECT_EQ(0min, minutes.minutes(QDate{2025, 1, 8}));
+  EXPECT_EQ(4h + 30min, minutes.minutes(project.id()));
+  EXPECT_EQ(4h + 30min, minutes.minutes());
+}
+
+TEST(DailyMinutesTest, IntervalsBeginningBeforePeriod)
+{
+  ProjectModel project_model;
+  const auto& a = project_model.add(std::make_unique<Project>("a", Qt::red));
+  const auto& b = project_model.add(std::make_unique<Project>("b", Qt::blue));
+  const auto i1 = make_interval(&a, january(5, 20), january(6, 1));
+  const auto i2 = make_interval(&b, january(6, 8), january(6, 9, 15));
+  const auto i3 = make_interval(&a, january(6, 10), january(6, 12));
+  const auto i4 = make_interval(&b, january(9, 10), january(9, 12));
+  const DailyMinutes minutes{Period{QDate{2025, 1, 6}, QDate{2025, 1, 6}}, {i4.get(), i3.get(), i2.get(), i1.get()}};
+  EXPECT_EQ(3h, minutes.minutes(QDate{2025, 1, 6}, a.id()));
+  EXPECT_EQ(1h + 15min, minutes.minutes(QDate{2025, 1, 6}, b.id()));
+  EXPECT_EQ(4h + 15min, minutes.minutes(QDate{2025, 1, 6}));
+  EXPECT_EQ(0min, minutes.minutes(QDate{2025, 1, 5}));
+  EXPECT_EQ(4h + 15min, minutes.minutes());
+}
+
+TEST(DailyMinutesTest, IntervalWithoutProject)
+{
+  auto interval = std::make_unique<Interval>(nullptr);
+  interval->swap_begin(january(6, 8));
+  interval->swap_end(january(6, 9));
+  const DailyMinutes minutes{Period{QDate{2025, 1, 6}, Period::Type::Week}, {interval.get()}};
+  EXPECT_EQ(0min, minutes.minutes());
+}
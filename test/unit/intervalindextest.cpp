@@ -0,0 +1,163 @@
+#include "intervalindex.h"
+#include "intervalmodel.h"
+#include "testutil.h"
+
+#include <gtest/gtest.h>
+
+TEST(IntervalIndexTest, TracksOverlaps)
+{
+  IntervalIndex index;
+  const auto a = ::make_interval(nullptr, ::january(3, 8), ::january(3, 12));
+  const auto b = ::make_interval(nullptr, ::january(3, 12), ::january(3, 14));
+  const auto c = ::make_interval(nullptr, ::january(4, 8), ::january(4, 16));
+  for (const auto& interval : {a.get(), b.get(), c.get()}) {
+    index.insert(*interval);
+  }
+  // touching intervals do not overlap.
+  EXPECT_EQ(index.overlapping_count(), 0);
+  EXPECT_EQ(index.last_end(), ::january(4, 16));
+
+  const auto long_interval = ::make_interval(nullptr, ::january(2, 20), ::january(3, 9));
+  index.insert(*long_interval);
+  EXPECT_TRUE(index.overlaps(*a));
+  EXPECT_TRUE(index.overlaps(*long_interval));
+  EXPECT_FALSE(index.overlaps(*b));
+  EXPECT_EQ(index.next_overlap(QDateTime{}), long_interval.get());
+  EXPECT_EQ(index.next_overlap(::january(2, 20)), a.get());
+  EXPECT_EQ(index.next_overlap(::january(3, 8)), nullptr);
+
+  // modifying an interval in place updates the overlaps of the others.
+  long_interval->swap_end(::january(3, 7));
+  index.update(*long_interval);
+  EXPECT_EQ(index.overlapping_count(), 0);
+
+  auto open_interval = std::make_unique<Interval>(nullptr);
+  open_interval->swap_begin(::january(4, 15));
+  index.insert(*open_interval);
+  EXPECT_TRUE(index.overlaps(*c));
+  EXPECT_EQ(index.overlapping_count(), 2);
+  EXPECT_EQ(index.last_end(), ::january(4, 16));
+
+  index.erase(*c);
+  EXPECT_EQ(index.overlapping_count(), 0);
+  EXPECT_EQ(index.last_end(), ::january(3, 14));
+}
+
+TEST(IntervalIndexTest, FollowsEditsAfterInvalidate)
+{
+  IntervalModel model;
+  model.add(::make_interval(nullptr, ::january(6, 8), ::january(6, 12)));
+  model.add(::make_interval(nullptr, ::january(8, 22), ::january(9, 2)));
+  auto& interval = model.remove_const(*model.interval(0));
+  auto& night_shift = model.remove_const(*model.interval(1));
+  const auto day = [](const int day) { return Period{QDate{2025, 1, day}, Period::Type::Day}; };
+  EXPECT_EQ(model.intervals(day(6)), std::vector{&interval});
+  EXPECT_EQ(model.intervals(day(9)), std::vector{&night_shift});
+
+  interval.swap_begin(::january(7, 8));
+  interval.swap_end(::january(7, 12));
+  model.invalidate(interval);
+  EXPECT_TRUE(model.intervals(day(6)).empty());
+  EXPECT_EQ(model.intervals(day(7)), std::vector{&interval});
+
+  // a longer span widens the range of begins which must be considered.
+  interval.swap_end(::january(10, 12));
+  model.invalidate(interval);
+  EXPECT_EQ(model.intervals(day(9)), (std::vector{&interval, &night_shift}));
+  EXPECT_EQ(model.intervals(day(10)), std::vector{&interval});
+
+  interval.swap_end(::january(7, 12));
+  model.invalidate(interval);
+  EXPECT_TRUE(model.intervals(day(10)).empty());
+  EXPECT_EQ(model.intervals(day(9)), std::vector{&night_shift});
+}
+
+TEST(IntervalIndexTest, OpenIntervals)
+{
+  IntervalIndex index;
+  const auto closed = ::make_interval(nullptr, ::january(6, 8), ::january(6, 12));
+  auto open = std::make_unique<Interval>(nullptr);
+  open->swap_begin(::january(8, 9));
+  index.insert(*closed);
+  index.insert(*open);
+
+  EXPECT_TRUE(index.overlapping(Period{QDate{2025, 1, 7}, Period::Type::Day}).empty());
+  EXPECT_EQ(index.overlapping(Period{QDate{2025, 1, 8}, Period::Type::Day}), std::vector{open.get()});
+  EXPECT_EQ(index.overlapping(Period{QDate{2025, 3, 1}, Period::Type::Month}), std::vector{open.get()});
+  EXPECT_EQ(index.overlapping(Period{QDate{2025, 1, 6}, QDate{2025, 1, 31}}), (std::vector{closed.get(), open.get()}));
+  EXPECT_EQ(index.indexed_period(*open, QDate{2025, 1, 20}), (Period{QDate{2025, 1, 8}, QDate{2025, 1, 20}}));
+  EXPECT_EQ(index.last_end(), ::january(6, 12));
+
+  open->swap_end(::january(9, 17));
+  index.update(*open);
+  EXPECT_TRUE(index.overlapping(Period{QDate{2025, 3, 1}, Period::Type::Month}).empty());
+  EXPECT_EQ(index.indexed_period(*open, QDate{2025, 1, 20}), (Period{QDate{2025, 1, 8}, QDate{2025, 1, 9}}));
+  EXPECT_EQ(index.last_end(), ::january(9, 17));
+}
+
+TEST(IntervalIndexTest, FindsGaps)
+{
+  IntervalIndex index;
+  const auto a = ::make_interval(nullptr, ::january(3, 8), ::january(3, 12));
+  const auto nested = ::make_interval(nullptr, ::january(3, 9), ::january(3, 10));
+  const auto touching = ::make_interval(nullptr, ::january(3, 12), ::january(3, 14));
+  const auto after_gap = ::make_interval(nullptr, ::january(3, 15), ::january(3, 17));
+  const auto next_day = ::make_interval(nullptr, ::january(4, 8), ::january(4, 12));
+  const auto after_next_day_gap = ::make_interval(nullptr, ::january(4, 13), ::january(4, 14));
+  auto open = std::make_unique<Interval>(nullptr);
+  open->swap_begin(::january(4, 16));
+  for (auto* const interval :
+       {a.get(), nested.get(), touching.get(), after_gap.get(), next_day.get(), after_next_day_gap.get(), open.get()})
+  {
+    index.insert(*interval);
+  }
+
+  // touching and nested intervals leave no gap, nor does the night between two days.
+  EXPECT_EQ(index.next_gap(QDateTime{}), after_gap.get());
+  EXPECT_EQ(index.next_gap(::january(3, 15)), after_next_day_gap.get());
+  EXPECT_EQ(index.next_gap(::january(4, 13)), open.get());
+  // an open interval covers all the time after its begin.
+  EXPECT_EQ(index.next_gap(::january(4, 16)), nullptr);
+
+  const auto covering = ::make_interval(nullptr, ::january(3, 13), ::january(3, 16));
+  index.insert(*covering);
+  EXPECT_EQ(index.next_gap(QDateTime{}), after_next_day_gap.get());
+}
+
+TEST(IntervalIndexTest, KeepsLongIntervalsAside)
+{
+  IntervalIndex index;
+  std::vector<std::unique_ptr<Interval>> short_intervals;
+  for (auto day = 2; day <= 28; ++day) {
+    short_intervals.emplace_back(::make_interval(nullptr, ::january(day, 8), ::january(day, 9)));
+    short_intervals.emplace_back(::make_interval(nullptr, ::january(day, 10), ::january(day, 11)));
+  }
+  for (const auto& interval : short_intervals) {
+    index.insert(*interval);
+  }
+  EXPECT_EQ(index.next_gap(::january(2, 9)), short_intervals.at(1).get());
+
+  // the long interval overlaps with the intervals of its days only, though it begins long before many of them.
+  const auto long_interval = ::make_interval(nullptr, ::january(1, 12), ::january(10, 9, 30));
+  index.insert(*long_interval);
+  EXPECT_EQ(index.overlapping_count(), 1 + 8 * 2 + 1);
+  EXPECT_TRUE(index.overlaps(*short_intervals.at(16)));
+  EXPECT_FALSE(index.overlaps(*short_intervals.at(17)));
+  EXPECT_EQ(index.overlapping(Period{QDate{2025, 1, 10}, Period::Type::Day}),
+            (std::vector{long_interval.get(), short_intervals.at(16).get(), short_intervals.at(17).get()}));
+  EXPECT_EQ(index.overlapping(Period{QDate{2025, 1, 20}, Period::Type::Day}),
+            (std::vector{short_intervals.at(36).get(), short_intervals.at(37).get()}));
+  EXPECT_EQ(index.indexed_period(*long_interval, QDate{}), (Period{QDate{2025, 1, 1}, QDate{2025, 1, 10}}));
+
+  // the long interval covers the time between the intervals of its days.
+  EXPECT_EQ(index.next_gap(::january(2, 9)), short_intervals.at(17).get());
+
+  const auto later_interval = ::make_interval(nullptr, ::january(20, 8), ::january(20, 12));
+  index.insert(*later_interval);
+  EXPECT_TRUE(index.overlaps(*later_interval));
+  EXPECT_FALSE(index.overlaps(*short_intervals.at(35)));
+
+  index.erase(*long_interval);
+  EXPECT_EQ(index.overlapping_count(), 3);
+  EXPECT_EQ(index.next_gap(::january(2, 9)), short_intervals.at(1).get());
+}
@@ -0,0 +1,130 @@
+#include "commands/addremovecommand.h"
+#include "commands/undostack.h"
+#include "intervalmodel.h"
+#include "testutil.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+[[nodiscard]] std::vector<const Interval*> rows(const IntervalModel& model)
+{
+  std::vector<const Interval*> intervals;
+  for (int row = 0; row < model.rowCount(); ++row) {
+    const auto* const interval = model.interval(static_cast<std::size_t>(row));
+    EXPECT_EQ(model.index(*interval).row(), row);
+    intervals.emplace_back(interval);
+  }
+  return intervals;
+}
+
+[[nodiscard]] std::vector<const Interval*> storage(const IntervalModel& model)
+{
+  const auto intervals = model.intervals();
+  return std::vector<const Interval*>(intervals.begin(), intervals.end());
+}
+
+[[nodiscard]] const Interval* add(IntervalModel& model, const int day)
+{
+  model.add(make_interval(nullptr, QDate{2025, 1, day}));
+  return model.interval(static_cast<std::size_t>(model.rowCount() - 1));
+}
+
+}  // namespace
+
+TEST(IntervalModelTest, KeepsStorageOrder)
+{
+  IntervalModel model;
+  const auto* const a = ::add(model, 6);
+  const auto* const b = ::add(model, 7);
+  const auto* const c = ::add(model, 8);
+  const auto* const d = ::add(model, 9);
+  const auto* const e = ::add(model, 10);
+
+  // the last row takes the place of the extracted interval.
+  const auto extracted = model.extract(*b);
+  EXPECT_EQ(::rows(model), (std::vector{a, e, c, d}));
+  EXPECT_EQ(::storage(model), (std::vector{a, c, d, e}));
+
+  model.split_interval(*c, QDateTime{QDate{2025, 1, 8}, QTime{10, 0}});
+  const auto* const right_half = model.interval(4);
+  EXPECT_EQ(right_half->begin(), (QDateTime{QDate{2025, 1, 8}, QTime{10, 0}}));
+  EXPECT_EQ(c->end(), right_half->begin());
+  EXPECT_EQ(::rows(model), (std::vector{a, e, c, d, right_half}));
+  EXPECT_EQ(::storage(model), (std::vector{a, c, right_half, d, e}));
+
+  UndoStack undo_stack;
+  undo_stack.push(make<RemoveCommand>(model, *a));
+  EXPECT_EQ(::rows(model), (std::vector{right_half, e, c, d}));
+  EXPECT_EQ(::storage(model), (std::vector{c, right_half, d, e}));
+  undo_stack.undo();
+  // undo adds the interval back as the last one.
+  EXPECT_EQ(::storage(model), (std::vector{c, right_half, d, e, a}));
+  undo_stack.redo();
+  EXPECT_EQ(::storage(model), (std::vector{c, right_half, d, e}));
+}
+
+TEST(IntervalModelTest, AddsAndExtractsMany)
+{
+  IntervalModel model;
+  std::vector<Period> changes;
+  QObject::connect(&model, &IntervalModel::data_changed, [&changes](const Period& period) {
+    changes.emplace_back(period);
+  });
+  auto insertions = 0;
+  QObject::connect(&model, &IntervalModel::rowsInserted, [&insertions]() { insertions += 1; });
+  auto removals = 0;
+  QObject::connect(&model, &IntervalModel::rowsRemoved, [&removals]() { removals += 1; });
+
+  std::vector<std::unique_ptr<Interval>> intervals;
+  for (const auto day : {6, 7, 8, 9, 10}) {
+    intervals.emplace_back(make_interval(nullptr, QDate{2025, 1, day}));
+  }
+  model.add(std::move(intervals));
+  EXPECT_EQ(insertions, 1);
+  EXPECT_EQ(changes, std::vector{Period(QDate{2025, 1, 6}, QDate{2025, 1, 10})});
+  const auto all = ::rows(model);
+  ASSERT_EQ(all.size(), 5);
+
+  // the scattered rows are moved to the end and removed at once.
+  const auto extracted = model.extract(std::set{all.at(1), all.at(2), all.at(4)});
+  EXPECT_EQ(removals, 1);
+  EXPECT_EQ(::rows(model), (std::vector{all.at(0), all.at(3)}));
+  EXPECT_EQ(::storage(model), (std::vector{all.at(0), all.at(3)}));
+  std::set<const Interval*> extracted_intervals;
+  for (const auto& interval : extracted) {
+    extracted_intervals.insert(interval.get());
+  }
+  EXPECT_EQ(extracted_intervals, (std::set{all.at(1), all.at(2), all.at(4)}));
+  EXPECT_EQ(changes.size(), 2);
+  EXPECT_EQ(changes.back(), Period(QDate{2025, 1, 7}, QDate{2025, 1, 10}));
+  EXPECT_TRUE(model.intervals(Period{QDate{2025, 1, 7}, Period::Type::Day}).empty());
+}
+
+TEST(IntervalModelTest, UndoesRemovingMany)
+{
+  IntervalModel model;
+  for (const auto day : {6, 7, 8, 9}) {
+    static_cast<void>(::add(model, day));
+  }
+  const auto all = ::rows(model);
+  const Period period{QDate{2025, 1, 6}, QDate{2025, 1, 9}};
+
+  UndoStack undo_stack;
+  undo_stack.push(make<RemoveManyCommand>(model, std::set{all.at(0), all.at(2)}));
+  EXPECT_EQ(::rows(model), (std::vector{all.at(3), all.at(1)}));
+  EXPECT_EQ(::storage(model), (std::vector{all.at(1), all.at(3)}));
+  EXPECT_EQ(model.intervals(period).size(), 2);
+
+  undo_stack.undo();
+  EXPECT_EQ(model.rowCount(), 4);
+  EXPECT_EQ(model.intervals(period).size(), 4);
+  EXPECT_EQ(::storage(model).size(), 4);
+
+  undo_stack.redo();
+  EXPECT_EQ(::storage(model), (std::vector{all.at(1), all.at(3)}));
+
+  undo_stack.undo();
+  EXPECT_EQ(model.rowCount(), 4);
+}
@@ -0,0 +1,62 @@
+#include "isodate.h"
+#include <gtest/gtest.h>
+
+namespace
+{
+
+constexpr auto step_days = 37;
+constexpr auto step_seconds = 3607;
+
+[[nodiscard]] std::string to_std_string(const QString& text)
+{
+  return text.toStdString();
+}
+
+}  // namespace
+
+TEST(IsoDateTest, DatesMatchQt)
+{
+  std::array<char, iso_date_size> buffer{};
+  for (auto date = QDate{1600, 2, 28}; date.year() < 2400; date = date.addDays(step_days)) {
+    const auto qt_text = ::to_std_string(date.toString(Qt::ISODate));
+    const auto text = ::format_iso_date(date, buffer);
+    ASSERT_TRUE(text.has_value());
+    EXPECT_EQ(*text, qt_text);
+    EXPECT_EQ(::parse_iso_date(qt_text), QDate::fromString(QString::fromStdString(qt_text), Qt::ISODate));
+  }
+}
+
+TEST(IsoDateTest, DateTimesMatchQt)
+{
+  std::array<char, iso_date_time_size> buffer{};
+  auto date_time = QDateTime{QDate{1999, 12, 31}, QTime{0, 0, 1}};
+  for (auto i = 0; i < 1000; ++i, date_time = date_time.addSecs(static_cast<qint64>(step_days) * step_seconds)) {
+    const auto qt_text = ::to_std_string(date_time.toString(Qt::ISODate));
+    const auto text = ::format_iso_date_time(date_time, buffer);
+    ASSERT_TRUE(text.has_value());
+    EXPECT_EQ(*text, qt_text);
+    EXPECT_EQ(::parse_iso_date_time(qt_text), QDateTime::fromString(QString::fromStdString(qt_text), Qt::ISODate));
+  }
+}
+
+TEST(IsoDateTest, LeapDays)
+{
+  EXPECT_EQ(::parse_iso_date("2024-02-29"), QDate(2024, 2, 29));
+  EXPECT_EQ(::parse_iso_date("2000-02-29"), QDate(2000, 2, 29));
+  EXPECT_FALSE(::parse_iso_date("2023-02-29").has_value());
+  EXPECT_FALSE(::parse_iso_date("1900-02-29").has_value());
+}
+
+TEST(IsoDateTest, RejectsOtherLayouts)
+{
+  for (const auto* const text : {"", "2024-1-01T00:00:00", "2024-01-01 00:00:00", "2024-01-01T24:00:00",
+                                 "2024-01-01T00:60:00", "2024-13-01T00:00:00", "2024-01-01T00:00:00Z",
+                                 "2024-01-01T00:00:00.000", "0000-01-01T00:00:00", "2024-01-01T0a:00:00"})
+  {
+    EXPECT_FALSE(::parse_iso_date_time(text).has_value()) << text;
+  }
+
+  std::array<char, iso_date_time_size> buffer{};
+  EXPECT_FALSE(::format_iso_date_time(QDateTime{}, buffer).has_value());
+  EXPECT_FALSE(::format_iso_date_time(QDateTime{QDate{2024, 1, 1}, QTime{0, 0}, Qt::UTC}, buffer).has_value());
+}
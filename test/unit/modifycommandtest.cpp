@@ -0,0 +1,41 @@
+#include "commands/commands.h"
+#include "commands/undostack.h"
+#include "intervalmodel.h"
+#include "testutil.h"
+
+#include <gtest/gtest.h>
+
+TEST(ModifyCommandTest, MergesConsecutiveModificationsOfSameField)
+{
+  IntervalModel model;
+  model.add(make_interval(nullptr, january(6, 8), january(6, 12)));
+  model.add(make_interval(nullptr, january(7, 8), january(7, 12)));
+  auto& a = model.remove_const(*model.interval(0));
+  auto& b = model.remove_const(*model.interval(1));
+
+  UndoStack undo_stack;
+  undo_stack.push(make_modify_interval_command(model, a, january(6, 13), &Interval::swap_end));
+  undo_stack.push(make_modify_interval_command(model, a, january(6, 14), &Interval::swap_end));
+  EXPECT_EQ(undo_stack.impl().count(), 1);
+  EXPECT_EQ(a.end(), january(6, 14));
+
+  undo_stack.undo();
+  EXPECT_EQ(a.end(), january(6, 12));
+  undo_stack.redo();
+  EXPECT_EQ(a.end(), january(6, 14));
+
+  // modifications of another interval or another field are separate steps.
+  undo_stack.push(make_modify_interval_command(model, b, january(7, 15), &Interval::swap_end));
+  undo_stack.push(make_modify_interval_command(model, b, january(7, 9), &Interval::swap_begin));
+  EXPECT_EQ(undo_stack.impl().count(), 3);
+
+  undo_stack.undo();
+  EXPECT_EQ(b.begin(), january(7, 8));
+  EXPECT_EQ(b.end(), january(7, 15));
+  undo_stack.undo();
+  EXPECT_EQ(b.end(), january(7, 12));
+  EXPECT_EQ(a.end(), january(6, 14));
+  undo_stack.undo();
+  EXPECT_EQ(a.end(), january(6, 12));
+  EXPECT_FALSE(undo_stack.impl().canUndo());
+}
@@ -0,0 +1,83 @@
+#include "intervalmodel.h"
+#include "testutil.h"
+#include "views/perioddetailproxymodel.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+[[nodiscard]] std::vector<const Interval*> proxy_rows(const PeriodDetailProxyModel& proxy, const IntervalModel& model)
+{
+  std::vector<const Interval*> intervals;
+  for (int row = 0; row < proxy.rowCount(); ++row) {
+    intervals.emplace_back(model.interval(static_cast<std::size_t>(proxy.mapToSource(proxy.index(row, 0)).row())));
+  }
+  return intervals;
+}
+
+[[nodiscard]] const Interval* add(IntervalModel& model, const QDateTime& begin, const QDateTime& end)
+{
+  model.add(make_interval(nullptr, begin, end));
+  return model.interval(static_cast<std::size_t>(model.rowCount() - 1));
+}
+
+}  // namespace
+
+TEST(PeriodDetailProxyModelTest, MapsInsertedAndRemovedRows)
+{
+  IntervalModel model;
+  PeriodDetailProxyModel proxy;
+  proxy.set_source_model(&model);
+  proxy.set_period(Period{QDate{2025, 1, 6}, Period::Type::Week});
+
+  const auto* const tuesday = ::add(model, january(7, 8), january(7, 12));
+  const auto* const later = ::add(model, january(20, 8), january(20, 12));
+  const auto* const monday = ::add(model, january(6, 8), january(6, 12));
+  EXPECT_EQ(::proxy_rows(proxy, model), (std::vector{monday, tuesday}));
+  EXPECT_EQ(proxy.mapFromSource(model.index(*tuesday)).row(), 1);
+  EXPECT_FALSE(proxy.mapFromSource(model.index(*later)).isValid());
+
+  const auto* const wednesday = ::add(model, january(8, 8), january(8, 12));
+  EXPECT_EQ(::proxy_rows(proxy, model), (std::vector{monday, tuesday, wednesday}));
+
+  const auto extracted = model.extract(*tuesday);
+  EXPECT_EQ(::proxy_rows(proxy, model), (std::vector{monday, wednesday}));
+  EXPECT_EQ(proxy.mapFromSource(model.index(*wednesday)).row(), 1);
+  EXPECT_FALSE(proxy.mapFromSource(model.index(*later)).isValid());
+
+  const auto extracted_many = model.extract(std::set{monday, later});
+  EXPECT_EQ(::proxy_rows(proxy, model), std::vector{wednesday});
+  EXPECT_EQ(proxy.mapToSource(proxy.index(0, 0)), model.index(*wednesday));
+}
+
+TEST(PeriodDetailProxyModelTest, RepositionsModifiedRows)
+{
+  IntervalModel model;
+  PeriodDetailProxyModel proxy;
+  proxy.set_source_model(&model);
+  proxy.set_period(Period{QDate{2025, 1, 6}, Period::Type::Week});
+
+  const auto* const a = ::add(model, january(6, 8), january(6, 12));
+  const auto* const b = ::add(model, january(7, 8), january(7, 9));
+  const auto* const c = ::add(model, january(8, 8), january(8, 16));
+  proxy.sort(IntervalModel::duration_column, Qt::DescendingOrder);
+  EXPECT_EQ(::proxy_rows(proxy, model), (std::vector{c, a, b}));
+
+  const QPersistentModelIndex persistent_index = proxy.index(1, 0);
+  auto& modified = model.remove_const(*b);
+  modified.swap_end(january(7, 20));
+  model.invalidate(modified);
+  EXPECT_EQ(::proxy_rows(proxy, model), (std::vector{b, c, a}));
+  EXPECT_EQ(persistent_index.row(), 2);
+
+  // intervals which leave the period are removed.
+  modified.swap_begin(january(20, 8));
+  modified.swap_end(january(20, 9));
+  model.invalidate(modified);
+  EXPECT_EQ(::proxy_rows(proxy, model), (std::vector{c, a}));
+
+  proxy.sort(IntervalModel::begin_column, Qt::AscendingOrder);
+  EXPECT_EQ(::proxy_rows(proxy, model), (std::vector{a, c}));
+  EXPECT_EQ(persistent_index.row(), 0);
+}
@@ -1,5 +1,6 @@
 #include "period.h"
 #include "fmt.h"
+#include <algorithm>
 #include <gtest/gtest.h>
 
 namespace
@@ -41,7 +42,7 @@ TEST_P(PeriodConstrainTestFixture, Constrain)
   const auto& [candidate, expected_constrained_period] = GetParam();
 
   const auto actual_constrained_period = candidate.constrained(::start_date, ::today);
-  ASSERT_EQ(actual_constrained_period.dates(), expected_constrained_period.dates());
+  ASSERT_TRUE(std::ranges::equal(actual_constrained_period.dates(), expected_constrained_period.dates()));
 }
 
 INSTANTIATE_TEST_CASE_P(PeriodConstrainTests, PeriodConstrainTestFixture,
@@ -71,3 +72,21 @@ INSTANTIATE_TEST_CASE_P(PeriodConstrainTests, PeriodConstrainTestFixture,
                                 .candidate = Period{2024y / October / 17, Period::Type::Month},
                                 .constrained_period = Period{today, Period::Type::Month},
                             }));
+
+TEST(DayNumberTest, MatchesQDate)
+{
+  static constexpr auto step_days = 11;
+  for (auto date = QDate{1900, 1, 1}; date.year() < 2100; date = date.addDays(step_days)) {
+    const DayNumber day{date};
+    EXPECT_EQ(day.date(), date);
+    EXPECT_EQ(day.day_of_week(), date.dayOfWeek());
+    const auto [year, month, day_of_month] = day.civil();
+    EXPECT_EQ(QDate(year, month, day_of_month), date);
+    EXPECT_EQ(Period(date, Period::Type::Week).end(), date.addDays(Qt::Sunday - date.dayOfWeek()));
+    EXPECT_EQ(Period(date, Period::Type::Month).end(), QDate(date.year(), date.month(), date.daysInMonth()));
+    EXPECT_EQ(Period(date, Period::Type::Year).begin(), QDate(date.year(), 1, 1));
+  }
+  EXPECT_FALSE(DayNumber{QDate{}}.is_valid());
+  EXPECT_FALSE((DayNumber{} + 1).is_valid());
+  EXPECT_LT(DayNumber{}, DayNumber{QDate{1900, 1, 1}});
+}
@@ -1,4 +1,8 @@
+#include "exceptions.h"
+#include "intervalmodel.h"
+#include "json.h"
 #include "plan.h"
+#include "testutil.h"
 
 #include <gtest/gtest.h>
 
@@ -23,6 +27,28 @@ TEST(PlanTest, KindsIn)
   EXPECT_EQ((std::vector{Normal, Normal, Normal}), plan.kinds_in(Period{QDate{2025, 6, 8}, QDate{2025, 6, 10}}));
   EXPECT_EQ((std::vector{Normal}), plan.kinds_in(Period{QDate{2025, 1, 7}, QDate{2025, 1, 7}}));
 
+  const auto runs = plan.kind_runs(Period{QDate{2024, 12, 30}, QDate{2025, 1, 12}});
+  ASSERT_EQ(runs.size(), 5);
+  EXPECT_EQ(runs.at(0).period, (Period{QDate{2024, 12, 30}, QDate{2024, 12, 31}}));
+  // adjacent entries of the same kind form a single run.
+  EXPECT_EQ(runs.at(1).period, (Period{QDate{2025, 1, 1}, QDate{2025, 1, 6}}));
+  EXPECT_EQ(runs.at(1).kind, Holiday);
+  EXPECT_EQ(runs.at(2).period, (Period{QDate{2025, 1, 7}, QDate{2025, 1, 9}}));
+  EXPECT_EQ(runs.at(2).kind, Normal);
+  EXPECT_EQ(runs.at(4).period, (Period{QDate{2025, 1, 11}, QDate{2025, 1, 12}}));
+
+  std::vector<Plan::Entry> entries;
+  for (auto row = 0; row < plan.rowCount({}); ++row) {
+    entries.emplace_back(plan.entry(row));
+  }
+  const Period period{QDate{2024, 12, 30}, QDate{2025, 1, 12}};
+  const auto snapshot_runs = Plan::kind_runs(entries, plan.holiday_calendar(), period);
+  ASSERT_EQ(runs.size(), snapshot_runs.size());
+  for (std::size_t i = 0; i < runs.size(); ++i) {
+    EXPECT_EQ(runs.at(i).period, snapshot_runs.at(i).period);
+    EXPECT_EQ(runs.at(i).kind, snapshot_runs.at(i).kind);
+  }
+
   const FullTimePlan empty_plan;
   EXPECT_EQ((std::vector(10, Normal)), empty_plan.kinds_in(Period{QDate{2025, 1, 1}, QDate{2025, 1, 10}}));
   EXPECT_EQ((std::vector(14, Normal)), empty_plan.kinds_in(Period{QDate{2024, 12, 30}, QDate{2025, 1, 12}}));
@@ -90,3 +116,130 @@ TEST(PlanTest, add_sorted)
   // add a period which overlap the two existing ones is expected to fail
   ASSERT_EQ(-1, add_period(QDate{2025, 1, 14}, QDate{2025, 3, 3}));
 }
+
+TEST(PlanTest, SetPeriodMovesRow)
+{
+  FullTimePlan plan;
+  for (const auto day : {1, 10, 20}) {
+    plan.add(std::make_unique<Plan::Entry>(Period{QDate{2025, 1, day}, Period::Type::Day}, Plan::Kind::Holiday));
+  }
+
+  auto moves = 0;
+  QObject::connect(&plan, &Plan::rowsMoved, [&moves]() { ++moves; });
+
+  // changing the period without changing the order does not move the row
+  plan.set_data(1, Period{QDate{2025, 1, 9}, QDate{2025, 1, 11}});
+  EXPECT_EQ(moves, 0);
+
+  plan.set_data(0, Period{QDate{2025, 1, 25}, Period::Type::Day});
+  EXPECT_EQ(moves, 1);
+  EXPECT_EQ(plan.entry(0).period.begin(), QDate(2025, 1, 9));
+  EXPECT_EQ(plan.entry(1).period.begin(), QDate(2025, 1, 20));
+  EXPECT_EQ(plan.entry(2).period.begin(), QDate(2025, 1, 25));
+
+  plan.set_data(2, Period{QDate{2025, 1, 1}, Period::Type::Day});
+  EXPECT_EQ(moves, 2);
+  EXPECT_EQ(plan.entry(0).period.begin(), QDate(2025, 1, 1));
+
+  // overlapping periods are rejected and the plan is left unchanged
+  EXPECT_THROW(plan.set_data(0, Period{QDate{2025, 1, 5}, QDate{2025, 1, 9}}), RuntimeError);
+  EXPECT_EQ(plan.entry(0).period.begin(), QDate(2025, 1, 1));
+  EXPECT_EQ(plan.find_kind(QDate{2025, 1, 20}), Plan::Kind::Holiday);
+  EXPECT_EQ(plan.find_kind(QDate{2025, 1, 21}), Plan::Kind::Normal);
+
+  const auto& entry = plan.entry(1);
+  EXPECT_EQ(plan.extract(entry)->period.begin(), QDate(2025, 1, 9));
+  EXPECT_EQ(plan.rowCount({}), 2);
+}
+
+TEST(PlanTest, PublicHolidays)
+{
+  using std::chrono_literals::operator""min;
+  using std::chrono_literals::operator""h;
+  const std::vector<HolidayRule> rules(german_public_holidays.begin(), german_public_holidays.end());
+  FullTimePlan plan{nlohmann::json{{"start", QDate{2025, 1, 1}}, {"overtime_offset", 0min}, {"holidays", rules}}};
+  plan.add(std::make_unique<Plan::Entry>(Period{QDate{2025, 4, 21}, QDate{2025, 4, 25}}, Plan::Kind::Vacation));
+
+  EXPECT_EQ(plan.find_kind(QDate{2025, 4, 18}), Plan::Kind::Holiday);
+  EXPECT_EQ(plan.find_kind(QDate{2025, 4, 17}), Plan::Kind::Normal);
+  // the entries take precedence over the public holidays.
+  EXPECT_EQ(plan.find_kind(QDate{2025, 4, 21}), Plan::Kind::Vacation);
+
+  using enum Plan::Kind;
+  EXPECT_EQ((std::vector{Normal, Holiday, Normal, Normal, Vacation, Vacation}),
+            plan.kinds_in(Period{QDate{2025, 4, 17}, QDate{2025, 4, 22}}));
+
+  // all holidays of 2025 but Easter Monday, which is vacation, are on weekdays.
+  EXPECT_EQ(plan.holiday_time(Period{QDate{2025, 1, 1}, Period::Type::Year}), 8 * 8h);
+  EXPECT_EQ(plan.to_json().at("holidays"), nlohmann::json(rules));
+}
+
+TEST(PlanTest, PlannedWorkingTimeOfPeriodIsSumOfDays)
+{
+  using namespace std::chrono_literals;
+  // an odd number of minutes per day, half days are rounded per day.
+  Schedule::Contract contract{.effective_from = QDate{2025, 1, 1}};
+  std::fill_n(contract.week.begin(), 5, 7h + 45min);
+  SchedulePlan plan{Schedule{std::vector{contract}}};
+  plan.add(std::make_unique<Plan::Entry>(Period{QDate{2025, 1, 7}, QDate{2025, 1, 8}}, Plan::Kind::HalfVacation));
+  plan.add(std::make_unique<Plan::Entry>(Period{QDate{2025, 1, 9}, QDate{2025, 1, 9}}, Plan::Kind::Sick));
+  plan.add(std::make_unique<Plan::Entry>(Period{QDate{2025, 1, 10}, QDate{2025, 1, 10}}, Plan::Kind::Vacation));
+
+  const Project project{"a", Qt::red};
+  IntervalModel interval_model;
+  interval_model.add(make_interval(&project, january(9, 8), january(9, 10)));
+
+  // Monday is a normal day, Tuesday and Wednesday are half vacation, Thursday is sick, Friday is vacation.
+  EXPECT_EQ(plan.planned_working_time(Period{QDate{2025, 1, 6}, QDate{2025, 1, 12}}, interval_model),
+            7h + 45min + 2 * 232min + 2h);
+}
+
+TEST(PlanTest, AddsManyEntriesAllOrNone)
+{
+  FullTimePlan plan;
+  ASSERT_TRUE(plan.add(std::make_unique<Plan::Entry>(Period{QDate{2025, 1, 10}, Period::Type::Day}, Plan::Kind::Sick)));
+
+  const auto entries = [](const std::vector<QDate>& days) {
+    std::vector<std::unique_ptr<Plan::Entry>> entries;
+    for (const auto& day : days) {
+      entries.emplace_back(std::make_unique<Plan::Entry>(Period{day, Period::Type::Day}, Plan::Kind::Vacation));
+    }
+    return entries;
+  };
+
+  // one overlapping entry rejects the whole batch.
+  EXPECT_FALSE(plan.add(entries({QDate{2025, 1, 6}, QDate{2025, 1, 10}, QDate{2025, 1, 14}})));
+  EXPECT_EQ(plan.rowCount(), 1);
+  EXPECT_FALSE(plan.add(entries({QDate{2025, 1, 6}, QDate{2025, 1, 6}})));
+  EXPECT_EQ(plan.rowCount(), 1);
+
+  EXPECT_TRUE(plan.add(entries({QDate{2025, 1, 14}, QDate{2025, 1, 6}})));
+  ASSERT_EQ(plan.rowCount(), 3);
+  EXPECT_EQ(plan.entry(0).period.begin(), QDate(2025, 1, 6));
+  EXPECT_EQ(plan.entry(1).period.begin(), QDate(2025, 1, 10));
+  EXPECT_EQ(plan.entry(2).period.begin(), QDate(2025, 1, 14));
+
+  const auto extracted = plan.extract(std::set{&plan.entry(0), &plan.entry(2)});
+  ASSERT_EQ(extracted.size(), 2);
+  ASSERT_EQ(plan.rowCount(), 1);
+  EXPECT_EQ(plan.entry(0).kind, Plan::Kind::Sick);
+}
+
+TEST(PlanTest, AdditiveKindsArePlannedFromTotalNormalWorkingTime)
+{
+  using std::chrono_literals::operator""min;
+  for (const auto kind : {Plan::Kind::Normal, Plan::Kind::Sick, Plan::Kind::Holiday, Plan::Kind::HalfHoliday,
+                          Plan::Kind::Vacation, Plan::Kind::HalfVacation, Plan::Kind::HalfVacationHalfHoliday})
+  {
+    const auto planned = [kind](const std::chrono::minutes normal) {
+      return Plan::planned_working_time(kind, normal, 0min);
+    };
+    EXPECT_EQ(Plan::depends_on_actual_working_time(kind),
+              planned(1min) != Plan::planned_working_time(kind, 1min, 1min)) << kind;
+    if (Plan::is_additive(kind)) {
+      EXPECT_FALSE(Plan::depends_on_actual_working_time(kind)) << kind;
+      EXPECT_EQ(planned(1min) + planned(1min), planned(2min)) << kind;
+    }
+  }
+  EXPECT_FALSE(Plan::is_additive(Plan::Kind::HalfVacation));
+}
@@ -0,0 +1,63 @@
+#include "exceptions.h"
+#include "period.h"
+#include "schedule.h"
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+namespace
+{
+
+using std::chrono_literals::operator""min;
+using std::chrono_literals::operator""h;
+
+[[nodiscard]] std::chrono::minutes sum_of_days(const Schedule& schedule, const Period& period)
+{
+  auto sum = 0min;
+  for (const auto date : period.dates()) {
+    sum += schedule.working_time(DayNumber{date});
+  }
+  return sum;
+}
+
+}  // namespace
+
+TEST(ScheduleTest, ClosedFormMatchesSumOfDays)
+{
+  const Schedule schedule{{
+      Schedule::Contract{.effective_from = QDate{2024, 3, 14}, .week = {4h, 4h, 4h, 0min, 0min, 0min, 0min}},
+      Schedule::Contract{.effective_from = QDate{2023, 7, 1}, .week = {8h, 8h, 8h, 8h, 6h, 0min, 0min}},
+      Schedule::Contract{.effective_from = QDate{2024, 9, 1}, .week = {7h, 7h, 7h, 7h, 7h, 1h, 0min}},
+  }};
+
+  EXPECT_EQ(schedule.working_time(DayNumber{QDate{2023, 6, 30}}), 0min);
+  EXPECT_EQ(schedule.working_time(DayNumber{QDate{2023, 7, 7}}), 6h);
+  EXPECT_EQ(schedule.working_time(DayNumber{QDate{2024, 3, 14}}), 0min);
+  EXPECT_EQ(schedule.working_time(DayNumber{QDate{2024, 3, 13}}), 4h);
+
+  for (auto begin = QDate{2023, 5, 1}; begin < QDate{2025, 1, 1}; begin = begin.addDays(11)) {
+    for (const auto days : {1, 3, 7, 9, 30, 200}) {
+      const Period period{begin, begin.addDays(days - 1)};
+      EXPECT_EQ(schedule.working_time(period), ::sum_of_days(schedule, period));
+    }
+  }
+}
+
+TEST(ScheduleTest, Serialization)
+{
+  EXPECT_EQ(Schedule::full_time().working_time(Period{QDate{2025, 1, 1}, Period::Type::Year}), 261 * 8h);
+
+  const Schedule schedule{{
+      Schedule::Contract{.effective_from = {}, .week = {8h, 8h, 8h, 8h, 8h, 0min, 0min}},
+      Schedule::Contract{.effective_from = QDate{2024, 3, 14}, .week = {4h, 4h, 4h, 0min, 0min, 0min, 0min}},
+  }};
+  const auto restored = nlohmann::json(schedule).get<Schedule>();
+  ASSERT_EQ(restored.contracts().size(), 2);
+  EXPECT_FALSE(restored.contracts().front().effective_from.isValid());
+  EXPECT_EQ(restored.contracts().back().effective_from, QDate(2024, 3, 14));
+  EXPECT_EQ(restored.contracts().back().week, schedule.contracts().back().week);
+
+  const auto duplicate = nlohmann::json::parse(R"([{"effective_from": "2024-01-01", "week": [0, 0, 0, 0, 0, 0, 0]},
+                                                   {"effective_from": "2024-01-01", "week": [1, 0, 0, 0, 0, 0, 0]}])");
+  EXPECT_THROW(duplicate.get<Schedule>(), RuntimeError);
+}
@@ -0,0 +1,300 @@
+#include "application.h"
+#include "exceptions.h"
+#include "intervalmodel.h"
+#include "plan.h"
+#include "projectmodel.h"
+#include "serialization.h"
+#include "testutil.h"
+#include "timesheet.h"
+
+#include <QThreadPool>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <sstream>
+
+namespace
+{
+
+using std::chrono_literals::operator""h;
+
+[[nodiscard]] std::filesystem::path make_directory(const std::string& name)
+{
+  const auto directory = std::filesystem::temp_directory_path() / name;
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory);
+  return directory;
+}
+
+[[nodiscard]] std::unique_ptr<TimeSheet> make_time_sheet(const QDate& plan_start)
+{
+  auto data = SchedulePlan{Schedule::full_time()}.to_json();
+  data["start"] = plan_start;
+  return std::make_unique<TimeSheet>(std::make_unique<ProjectModel>(), std::make_unique<IntervalModel>(),
+                                     std::make_unique<SchedulePlan>(data));
+}
+
+[[nodiscard]] nlohmann::json segment_reference(const std::filesystem::path& filename, const int year)
+{
+  std::ifstream file{filename};
+  for (const auto& segment : nlohmann::json::parse(file).at("segments")) {
+    if (segment.at("year").get<int>() == year) {
+      return segment;
+    }
+  }
+  return {};
+}
+
+}  // namespace
+
+TEST(SerializationTest, LoadsPastYearsOnDemand)
+{
+  const auto directory = ::make_directory("tire-serialization-test");
+  const auto filename = directory / "sheet.ts";
+  const auto current_year = Application::current_date_time().date().year();
+
+  {
+    TimeSheet time_sheet;
+    const auto& project = time_sheet.project_model().add(std::make_unique<Project>("a", Qt::red));
+    for (const auto year : {current_year - 3, current_year - 1, current_year}) {
+      time_sheet.interval_model().add(make_interval(&project, QDate{year, 1, 2}));
+    }
+    ::save(time_sheet, filename);
+  }
+
+  EXPECT_TRUE(std::filesystem::exists(directory / fmt::format("sheet.{}.ts", current_year - 3)));
+  EXPECT_TRUE(std::filesystem::exists(directory / fmt::format("sheet.{}.ts", current_year - 1)));
+
+  const auto time_sheet = ::load(filename);
+  // the previous year is loaded eagerly since its intervals may extend into the current year.
+  ASSERT_EQ(time_sheet->unloaded_segments().size(), 1);
+  EXPECT_TRUE(time_sheet->unloaded_segments().contains(current_year - 3));
+  EXPECT_EQ(time_sheet->interval_model().rowCount(), 2);
+
+  time_sheet->load_segments(Period{QDate{current_year - 3, 6, 1}, Period::Type::Month});
+  EXPECT_TRUE(time_sheet->unloaded_segments().empty());
+  EXPECT_EQ(time_sheet->interval_model().rowCount(), 3);
+}
+
+TEST(SerializationTest, KeepsSegmentWhichFailedToLoad)
+{
+  const auto directory = ::make_directory("tire-serialization-failed-segment-test");
+  const auto filename = directory / "sheet.ts";
+  const auto year = Application::current_date_time().date().year() - 3;
+  const auto segment_filename = directory / fmt::format("sheet.{}.ts", year);
+  const auto moved_filename = directory / "moved.ts";
+
+  {
+    TimeSheet time_sheet;
+    const auto& project = time_sheet.project_model().add(std::make_unique<Project>("a", Qt::red));
+    time_sheet.interval_model().add(make_interval(&project, QDate{year, 1, 2}));
+    ::save(time_sheet, filename);
+  }
+
+  const auto time_sheet = ::load(filename);
+  const auto* const project = time_sheet->project_model().projects().front().get();
+  // the segment fails to load on demand, hence its year stays unloaded although it has an interval now.
+  std::filesystem::rename(segment_filename, moved_filename);
+  time_sheet->interval_model().add(make_interval(project, QDate{year, 1, 3}));
+  ASSERT_TRUE(time_sheet->unloaded_segments().contains(year));
+
+  // saving must neither overwrite nor drop the segment.
+  EXPECT_THROW(::save(*time_sheet, filename), RuntimeError);
+  EXPECT_FALSE(std::filesystem::exists(segment_filename));
+
+  std::filesystem::rename(moved_filename, segment_filename);
+  ::save(*time_sheet, filename);
+  EXPECT_TRUE(time_sheet->unloaded_segments().empty());
+
+  std::ifstream file{filename};
+  auto references = 0;
+  for (const auto& segment : nlohmann::json::parse(file).at("segments")) {
+    references += segment.at("year").get<int>() == year ? 1 : 0;
+  }
+  EXPECT_EQ(references, 1);
+
+  const auto restored = ::load(filename);
+  restored->load_segments(Period{QDate{year, 1, 1}, Period::Type::Year});
+  EXPECT_EQ(restored->interval_model().rowCount(), 2);
+}
+
+TEST(SerializationTest, BalanceOfUnloadedYearsMatchesLoadedYears)
+{
+  const auto directory = ::make_directory("tire-serialization-balance-test");
+  const auto filename = directory / "sheet.ts";
+  const auto current_year = Application::current_date_time().date().year();
+  const QDate plan_start{current_year - 3, 1, 1};
+
+  {
+    const auto time_sheet = ::make_time_sheet(plan_start);
+    const auto& project = time_sheet->project_model().add(std::make_unique<Project>("a", Qt::red));
+    time_sheet->interval_model().add(make_interval(&project, QDate{current_year - 3, 3, 4}));
+    time_sheet->interval_model().add(make_interval(&project, QDate{current_year - 2, 5, 6}));
+    time_sheet->plan().add(std::make_unique<Plan::Entry>(Period{QDate{current_year - 2, 5, 7}, Period::Type::Day},
+                                                         Plan::Kind::Vacation));
+    ::save(*time_sheet, filename);
+  }
+
+  const auto partial = ::load(filename);
+  ASSERT_EQ(partial->unloaded_segments().size(), 2);
+  const auto complete = ::load(filename);
+  complete->load_segments(Period{plan_start, QDate{current_year - 2, 12, 31}});
+  ASSERT_TRUE(complete->unloaded_segments().empty());
+
+  const Period history{plan_start, Application::current_date_time().date()};
+  auto& pool = *QThreadPool::globalInstance();
+  const Aggregation partial_aggregation{partial->snapshot(), history, pool};
+  const Aggregation complete_aggregation{complete->snapshot(), history, pool};
+  const auto periods = {
+      history,
+      Period{plan_start, Period::Type::Year},
+      Period{QDate{current_year - 2, 1, 1}, history.end()},
+  };
+  for (const auto& period : periods) {
+    const auto expected = complete_aggregation.totals(period);
+    const auto totals = partial->totals(partial_aggregation, period);
+    EXPECT_EQ(totals.actual, expected.actual);
+    EXPECT_EQ(totals.planned, expected.planned);
+    EXPECT_EQ(totals.vacation, expected.vacation);
+  }
+}
+
+TEST(SerializationTest, AccountsTimeCarriedOverFromUnloadedYear)
+{
+  const auto directory = ::make_directory("tire-serialization-carry-over-test");
+  const auto filename = directory / "sheet.ts";
+  const auto current_year = Application::current_date_time().date().year();
+  const QDate plan_start{current_year - 3, 1, 1};
+
+  {
+    const auto time_sheet = ::make_time_sheet(plan_start);
+    const auto& project = time_sheet->project_model().add(std::make_unique<Project>("a", Qt::red));
+    auto& interval_model = time_sheet->interval_model();
+    interval_model.add(make_interval(&project, QDate{current_year - 3, 1, 2}));
+    // runs past midnight into the first day of the previous year, which is loaded eagerly.
+    interval_model.add(make_interval(&project, QDateTime{QDate{current_year - 2, 12, 31}, QTime{22, 0}},
+                                     QDateTime{QDate{current_year - 1, 1, 1}, QTime{2, 0}}));
+    interval_model.add(make_interval(&project, QDate{current_year - 1, 1, 2}));
+    ::save(*time_sheet, filename);
+  }
+
+  const auto partial = ::load(filename);
+  ASSERT_TRUE(partial->unloaded_segments().contains(current_year - 2));
+  EXPECT_EQ(partial->unloaded_segments().at(current_year - 2).carry_over, 2h);
+  const auto complete = ::load(filename);
+  complete->load_segments(Period{plan_start, QDate{current_year - 2, 12, 31}});
+  ASSERT_TRUE(complete->unloaded_segments().empty());
+
+  const Period history{plan_start, Application::current_date_time().date()};
+  auto& pool = *QThreadPool::globalInstance();
+  const Aggregation partial_aggregation{partial->snapshot(), history, pool};
+  const Aggregation complete_aggregation{complete->snapshot(), history, pool};
+  const auto periods = {
+      history,
+      Period{QDate{current_year - 1, 1, 1}, Period::Type::Day},
+      Period{QDate{current_year - 1, 1, 1}, Period::Type::Year},
+      Period{plan_start, QDate{current_year - 2, 12, 31}},
+  };
+  for (const auto& period : periods) {
+    const auto expected = complete_aggregation.totals(period);
+    const auto totals = partial->totals(partial_aggregation, period);
+    EXPECT_EQ(totals.actual, expected.actual);
+    EXPECT_EQ(totals.planned, expected.planned);
+  }
+
+  // the stored totals of the previous year include the time carried over while the year before is unloaded.
+  ::save(*partial, filename);
+  const auto segment = ::segment_reference(filename, current_year - 1);
+  ASSERT_FALSE(segment.is_null());
+  EXPECT_EQ(std::chrono::milliseconds{segment.at("totals").at("actual").get<std::int64_t>()}, 6h);
+}
+
+TEST(SerializationTest, ReportsEarliestInvalidIntervalOfParallelDecoding)
+{
+  TimeSheet time_sheet;
+  const auto& project = time_sheet.project_model().add(std::make_unique<Project>("a", Qt::red));
+  // several chunks of 1024 intervals are decoded in parallel.
+  for (auto day = 0; day < 2500; ++day) {
+    time_sheet.interval_model().add(make_interval(&project, QDate{2020, 1, 1}.addDays(day)));
+  }
+  std::ostringstream out;
+  ::serialize(time_sheet, out);
+  auto json = nlohmann::json::parse(out.str());
+  ASSERT_EQ(::deserialize(json)->interval_model().rowCount(), 2500);
+
+  // an invalid project reference in the second chunk precedes a missing begin in the third chunk.
+  json.at("intervals").at(1500).at("project") = 99;
+  json.at("intervals").at(2400).erase("begin");
+  try {
+    static_cast<void>(::deserialize(json));
+    FAIL() << "expected DeserializationError";
+  } catch (const DeserializationError& e) {
+    EXPECT_NE(std::string{e.what()}.find("project reference"), std::string::npos) << e.what();
+  }
+
+  json.at("intervals").at(1500).at("project") = 0;
+  EXPECT_THROW(static_cast<void>(::deserialize(json)), DeserializationError);
+}
+
+TEST(SerializationTest, StreamsCompactJson)
+{
+  TimeSheet time_sheet;
+  const auto& project = time_sheet.project_model().add(std::make_unique<Project>("\"a\"\n\tb\x01 ä", Qt::red));
+  time_sheet.interval_model().add(make_interval(&project, QDate{2024, 2, 29}));
+  auto open_interval = std::make_unique<Interval>(nullptr);
+  open_interval->swap_begin(QDateTime{QDate{2024, 3, 1}, QTime{9, 30}});
+  time_sheet.interval_model().add(std::move(open_interval));
+
+  std::ostringstream out;
+  ::serialize(time_sheet, out);
+  const auto text = out.str();
+  // byte-identical to nlohmann's compact dump
+  EXPECT_EQ(text, nlohmann::json::parse(text).dump());
+
+  const auto restored = ::deserialize(nlohmann::json::parse(text));
+  ASSERT_EQ(restored->interval_model().rowCount(), 2);
+  EXPECT_EQ(restored->project_model().projects().front()->name(), project.name());
+  EXPECT_EQ(restored->interval_model().interval(0)->begin(), QDateTime(QDate{2024, 2, 29}, QTime{8, 0}));
+  EXPECT_FALSE(restored->interval_model().interval(1)->end().isValid());
+}
+
+TEST(SerializationTest, DecodesIntervalsWhileParsingFile)
+{
+  const auto directory = ::make_directory("tire-serialization-sax-test");
+  const auto filename = directory / "sheet.ts";
+  TimeSheet time_sheet;
+  const auto& project = time_sheet.project_model().add(std::make_unique<Project>("a", Qt::red));
+  time_sheet.interval_model().add(make_interval(&project, QDate{2024, 2, 29}));
+  auto open_interval = std::make_unique<Interval>(nullptr);
+  open_interval->swap_begin(QDateTime{QDate{2024, 3, 1}, QTime{9, 30}});
+  time_sheet.interval_model().add(std::move(open_interval));
+  std::ostringstream out;
+  ::serialize(time_sheet, out);
+  auto json = nlohmann::json::parse(out.str());
+
+  const auto load = [&filename](const nlohmann::json& json) {
+    std::ofstream{filename} << json.dump();
+    return ::load(filename);
+  };
+
+  // unknown values of an interval are skipped, including nested ones.
+  json.at("intervals").at(0)["note"] = {{"tags", {1, "x", nullptr}}};
+  const auto restored = load(json);
+  ASSERT_EQ(restored->interval_model().rowCount(), 2);
+  EXPECT_EQ(restored->interval_model().interval(0)->project()->name(), project.name());
+  EXPECT_EQ(restored->interval_model().interval(0)->end(), QDateTime(QDate{2024, 2, 29}, QTime{12, 0}));
+  EXPECT_EQ(restored->interval_model().interval(1)->project(), nullptr);
+  EXPECT_FALSE(restored->interval_model().interval(1)->end().isValid());
+
+  auto invalid_project = json;
+  invalid_project.at("intervals").at(0).at("project") = 1;
+  EXPECT_THROW(static_cast<void>(load(invalid_project)), DeserializationError);
+
+  auto missing_begin = json;
+  missing_begin.at("intervals").at(1).erase("begin");
+  EXPECT_THROW(static_cast<void>(load(missing_begin)), DeserializationError);
+
+  auto invalid_begin = json;
+  invalid_begin.at("intervals").at(1).at("begin") = 42;
+  EXPECT_THROW(static_cast<void>(load(invalid_begin)), DeserializationError);
+}
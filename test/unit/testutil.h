@@ -0,0 +1,31 @@
+#pragma once
+
+#include "interval.h"
+
+#include <QDateTime>
+#include <memory>
+
+/**
+ * @brief returns a closed interval of the given project, which may be null.
+ */
+[[nodiscard]] inline std::unique_ptr<Interval> make_interval(const Project* const project, const QDateTime& begin,
+                                                             const QDateTime& end)
+{
+  auto interval = std::make_unique<Interval>(project);
+  interval->swap_begin(begin);
+  interval->swap_end(end);
+  return interval;
+}
+
+/**
+ * @brief returns an interval of the given project from 08:00 to 12:00 on the given date.
+ */
+[[nodiscard]] inline std::unique_ptr<Interval> make_interval(const Project* const project, const QDate& date)
+{
+  return make_interval(project, QDateTime{date, QTime{8, 0}}, QDateTime{date, QTime{12, 0}});
+}
+
+[[nodiscard]] inline QDateTime january(const int day, const int hour, const int minute = 0)
+{
+  return QDateTime{QDate{2025, 1, day}, QTime{hour, minute}};
+}
@@ -0,0 +1,91 @@
+#include "intervalmodel.h"
+#include "projectmodel.h"
+#include "testutil.h"
+#include "timesheet.h"
+#include "timesheetsnapshot.h"
+
+#include <gtest/gtest.h>
+
+TEST(TimeSheetSnapshotTest, SharesUnchangedParts)
+{
+  TimeSheet time_sheet;
+  const auto& project = time_sheet.project_model().add(std::make_unique<Project>("a", Qt::red));
+  std::vector<std::unique_ptr<Interval>> intervals;
+  for (std::size_t i = 0; i < 2 * TimeSheetSnapshot::chunk_size + 1; ++i) {
+    auto& interval = *intervals.emplace_back(std::make_unique<Interval>(&project));
+    interval.swap_begin(january(1, 8));
+    interval.swap_end(january(1, 9));
+  }
+  time_sheet.interval_model().add(std::move(intervals));
+
+  const auto first = time_sheet.snapshot();
+  ASSERT_EQ(2 * TimeSheetSnapshot::chunk_size + 1, first->interval_count());
+  ASSERT_EQ(3, first->interval_chunks().size());
+  ASSERT_EQ(1, first->projects().size());
+  EXPECT_EQ(first, time_sheet.snapshot());
+
+  const auto changed_row = TimeSheetSnapshot::chunk_size + 1;
+  auto& interval = time_sheet.interval_model().remove_const(*time_sheet.interval_model().interval(changed_row));
+  interval.swap_end(january(1, 10));
+  time_sheet.interval_model().invalidate(interval);
+
+  const auto second = time_sheet.snapshot();
+  EXPECT_NE(first, second);
+  EXPECT_EQ(first->interval_chunks().at(0), second->interval_chunks().at(0));
+  EXPECT_NE(first->interval_chunks().at(1), second->interval_chunks().at(1));
+  EXPECT_EQ(first->interval_chunks().at(2), second->interval_chunks().at(2));
+  EXPECT_EQ(&first->plan(), &second->plan());
+  EXPECT_EQ(&first->projects(), &second->projects());
+  EXPECT_EQ(january(1, 9), first->interval(changed_row).end);
+  EXPECT_EQ(january(1, 10), second->interval(changed_row).end);
+  EXPECT_EQ(project.id(), second->interval(changed_row).project_id);
+}
+
+TEST(TimeSheetSnapshotTest, ExtractingProjectRenumbersIntervals)
+{
+  using std::chrono_literals::operator""h;
+  TimeSheet time_sheet;
+  auto& project_model = time_sheet.project_model();
+  const auto& a = project_model.add(std::make_unique<Project>("a", Qt::red));
+  const auto& b = project_model.add(std::make_unique<Project>("b", Qt::green));
+  const auto& c = project_model.add(std::make_unique<Project>("c", Qt::blue));
+  auto& interval_model = time_sheet.interval_model();
+  interval_model.add(make_interval(&a, january(2, 8), january(2, 9)));
+  interval_model.add(make_interval(&c, january(3, 8), january(3, 11)));
+
+  const auto first = time_sheet.snapshot();
+  ASSERT_EQ(2, first->interval(1).project_id);
+
+  const auto extracted = project_model.extract(b);
+  ASSERT_EQ(1, c.id());
+
+  const auto second = time_sheet.snapshot();
+  ASSERT_EQ(2, second->projects().size());
+  EXPECT_EQ(0, second->interval(0).project_id);
+  EXPECT_EQ(1, second->interval(1).project_id);
+  EXPECT_EQ(c.name(), second->projects().at(second->interval(1).project_id).name);
+
+  const Period january_period{QDate{2025, 1, 1}, Period::Type::Month};
+  EXPECT_EQ(1h, interval_model.minutes(january_period, a.id()));
+  EXPECT_EQ(3h, interval_model.minutes(january_period, c.id()));
+}
+
+TEST(TimeSheetSnapshotTest, ExtractingIntervalRefreshesReassignedRow)
+{
+  TimeSheet time_sheet;
+  auto& interval_model = time_sheet.interval_model();
+  std::vector<std::unique_ptr<Interval>> intervals;
+  for (std::size_t i = 0; i < TimeSheetSnapshot::chunk_size + 1; ++i) {
+    intervals.emplace_back(make_interval(nullptr, january(1, 8), january(1, 9)));
+  }
+  intervals.back()->swap_end(january(1, 10));
+  interval_model.add(std::move(intervals));
+  const auto first = time_sheet.snapshot();
+
+  // the last interval moves into the first row.
+  const auto extracted = interval_model.extract(*interval_model.interval(0));
+  const auto second = time_sheet.snapshot();
+  ASSERT_EQ(TimeSheetSnapshot::chunk_size, second->interval_count());
+  EXPECT_EQ(january(1, 10), second->interval(0).end);
+  EXPECT_EQ(january(1, 9), first->interval(0).end);
+}
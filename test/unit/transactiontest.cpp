@@ -0,0 +1,84 @@
+#include "commands/addremovecommand.h"
+#include "commands/undostack.h"
+#include "intervalmodel.h"
+#include "plan.h"
+#include "testutil.h"
+#include "transaction.h"
+
+#include <gtest/gtest.h>
+
+TEST(TransactionTest, DefersUntilOutermostTransactionEnds)
+{
+  auto notifications = 0;
+  const auto notify = [&notifications]() { notifications += 1; };
+  const auto key = 0;
+  const auto other_key = 1;
+  {
+    const Transaction outer;
+    {
+      const Transaction inner;
+      Transaction::defer(&key, notify);
+      Transaction::defer(&key, notify);
+    }
+    EXPECT_EQ(notifications, 0);
+    Transaction::defer(&other_key, notify);
+    EXPECT_EQ(notifications, 0);
+  }
+  // one notification per key.
+  EXPECT_EQ(notifications, 2);
+
+  Transaction::defer(&key, notify);
+  EXPECT_EQ(notifications, 3);
+}
+
+TEST(TransactionTest, EmitsMergedPeriodOnce)
+{
+  IntervalModel interval_model;
+  FullTimePlan plan;
+  std::vector<Period> interval_changes;
+  std::vector<Period> plan_changes;
+  QObject::connect(&interval_model, &IntervalModel::data_changed,
+                   [&interval_changes](const Period& period) { interval_changes.emplace_back(period); });
+  QObject::connect(&plan, &Plan::plan_changed, [&plan_changes](const Period& period) {
+    plan_changes.emplace_back(period);
+  });
+
+  {
+    const Transaction transaction;
+    interval_model.add(make_interval(nullptr, QDate{2025, 1, 6}));
+    {
+      const Transaction nested_transaction;
+      interval_model.add(make_interval(nullptr, QDate{2025, 1, 9}));
+      plan.add(std::make_unique<Plan::Entry>(Period{QDate{2025, 2, 3}, QDate{2025, 2, 4}}, Plan::Kind::Vacation));
+    }
+    plan.add(std::make_unique<Plan::Entry>(Period{QDate{2025, 2, 10}, QDate{2025, 2, 10}}, Plan::Kind::Sick));
+    EXPECT_TRUE(interval_changes.empty());
+    EXPECT_TRUE(plan_changes.empty());
+  }
+
+  EXPECT_EQ(interval_changes, std::vector{Period(QDate{2025, 1, 6}, QDate{2025, 1, 9})});
+  EXPECT_EQ(plan_changes, std::vector{Period(QDate{2025, 2, 3}, QDate{2025, 2, 10})});
+}
+
+TEST(TransactionTest, UndoAndRedoOfMacroEmitAfterCompletion)
+{
+  IntervalModel model;
+  std::vector<int> row_counts;
+  QObject::connect(&model, &IntervalModel::data_changed,
+                   [&row_counts, &model](const Period&) { row_counts.emplace_back(model.rowCount()); });
+
+  UndoStack undo_stack;
+  {
+    const auto macro = undo_stack.start_macro("add two intervals");
+    undo_stack.push(make<AddCommand>(model, make_interval(nullptr, QDate{2025, 1, 6})));
+    undo_stack.push(make<AddCommand>(model, make_interval(nullptr, QDate{2025, 1, 7})));
+    EXPECT_TRUE(row_counts.empty());
+  }
+  EXPECT_EQ(row_counts, std::vector{2});
+
+  undo_stack.undo();
+  EXPECT_EQ(row_counts, (std::vector{2, 0}));
+
+  undo_stack.redo();
+  EXPECT_EQ(row_counts, (std::vector{2, 0, 2}));
+}